@@ -3,18 +3,14 @@
 #           SPDX-License-Identifier: BSD-3-Clause
 ############################################################################
 
-## @param SVG_FILENAME absolute filename to the svg
-## @param QVG_FILENAME absolute filename to the qvg
-function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
-    get_filename_component(QVG_FILENAME ${QVG_FILENAME} ABSOLUTE)
-    get_filename_component(SVG_FILENAME ${SVG_FILENAME} ABSOLUTE)
-
+# sets Svg2QvgLocation, QtSvgTargetDirectory and script
+macro(_qsk_svg2qvg_setup)
     if(TARGET Qt6::Svg)
         set(QtSvgTarget Qt6::Svg)
     elseif(TARGET Qt5::Svg)
         set(QtSvgTarget Qt5::Svg)
     endif()
-    
+
     # find svg2qvg target location
     get_target_property(Svg2QvgLocation Qsk::Svg2Qvg LOCATION)
     get_filename_component(Svg2QvgDirectory ${Svg2QvgLocation} DIRECTORY)
@@ -37,12 +33,87 @@ function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
     else()
         message(FATAL "Unsupported operating system")
     endif()
-    
+endmacro()
+
+## @param SVG_FILENAME absolute filename to the svg
+## @param QVG_FILENAME absolute filename to the qvg
+function(qsk_svg2qvg SVG_FILENAME QVG_FILENAME)
+    get_filename_component(QVG_FILENAME ${QVG_FILENAME} ABSOLUTE)
+    get_filename_component(SVG_FILENAME ${SVG_FILENAME} ABSOLUTE)
+
+    _qsk_svg2qvg_setup()
+
     add_custom_command(
         COMMAND ${script} ${Svg2QvgLocation} ${SVG_FILENAME} ${QVG_FILENAME} ${QtSvgTargetDirectory}
         OUTPUT ${QVG_FILENAME}
         DEPENDS ${SVG_FILENAME}
-        COMMENT "Compiling ${SVG_FILENAME} to ${QVG_FILENAME}"        
+        COMMENT "Compiling ${SVG_FILENAME} to ${QVG_FILENAME}"
         VERBATIM)
 endfunction()
 
+## Converts many svgs by one invocation of svg2qvg, that runs the
+## conversions in parallel and skips files, whose content has not been
+## modified since the previous build.
+##
+## @param TARGET name of a custom target, that converts the files
+## @param OUTPUT_DIRECTORY directory for the qvg files ( <name>.svg -> <name>.qvg )
+## @param SVG_FILES the svgs
+## @param OPTIONS options for svg2qvg: --mappable, --tessellate
+## @param QVG_FILES name of a variable, that receives the list of qvg files
+function(qsk_svg2qvg_batch TARGET)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "OUTPUT_DIRECTORY;QVG_FILES" "SVG_FILES;OPTIONS")
+
+    if(NOT arg_OUTPUT_DIRECTORY)
+        set(arg_OUTPUT_DIRECTORY ${CMAKE_CURRENT_BINARY_DIR})
+    endif()
+
+    get_filename_component(arg_OUTPUT_DIRECTORY ${arg_OUTPUT_DIRECTORY} ABSOLUTE)
+    file(MAKE_DIRECTORY ${arg_OUTPUT_DIRECTORY})
+
+    _qsk_svg2qvg_setup()
+
+    set(manifestContent "")
+    foreach(option ${arg_OPTIONS})
+        string(APPEND manifestContent "${option}\n")
+    endforeach()
+
+    set(svgFiles "")
+    set(qvgFiles "")
+
+    foreach(svgFile ${arg_SVG_FILES})
+        get_filename_component(svgFile ${svgFile} ABSOLUTE)
+        get_filename_component(name ${svgFile} NAME_WE)
+
+        set(qvgFile ${arg_OUTPUT_DIRECTORY}/${name}.qvg)
+        if(qvgFile IN_LIST qvgFiles)
+            message(FATAL_ERROR "qsk_svg2qvg_batch: duplicate output ${qvgFile}")
+        endif()
+
+        list(APPEND svgFiles ${svgFile})
+        list(APPEND qvgFiles ${qvgFile})
+
+        string(APPEND manifestContent "${svgFile}\t${qvgFile}\n")
+    endforeach()
+
+    # only touching the manifest, when its content has changed
+    set(manifest ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}.svg2qvg)
+    file(GENERATE OUTPUT ${manifest} CONTENT "${manifestContent}")
+
+    # the outputs of unmodified files are not rewritten, so we need a stamp
+    set(stamp ${CMAKE_CURRENT_BINARY_DIR}/${TARGET}.stamp)
+
+    add_custom_command(
+        COMMAND ${script} ${Svg2QvgLocation} --batch ${manifest} ${QtSvgTargetDirectory}
+        COMMAND ${CMAKE_COMMAND} -E touch ${stamp}
+        OUTPUT ${stamp}
+        BYPRODUCTS ${qvgFiles}
+        DEPENDS ${svgFiles} ${manifest}
+        COMMENT "Compiling svgs of ${TARGET}"
+        VERBATIM)
+
+    add_custom_target(${TARGET} DEPENDS ${stamp})
+
+    if(arg_QVG_FILES)
+        set(${arg_QVG_FILES} ${qvgFiles} PARENT_SCOPE)
+    endif()
+endfunction()
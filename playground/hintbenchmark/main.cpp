@@ -0,0 +1,397 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for the lookups of skin hints. It can be run
+    without GPU as no window is created:
+
+        hintbenchmark [ --rounds <n> ] [ --csv ]
+
+    Allocations are counted by replacing the global operator new. Memory,
+    that is allocated by the containers of Qt using malloc, is not included.
+ */
+
+#include <material3/QskMaterial3SkinFactory.h>
+#include <fluent2/QskFluent2SkinFactory.h>
+#include <fusion/QskFusionSkinFactory.h>
+
+#include <QskAnimationHint.h>
+#include <QskBoxHints.h>
+#include <QskCheckBox.h>
+#include <QskComboBox.h>
+#include <QskControl.h>
+#include <QskProgressBar.h>
+#include <QskPushButton.h>
+#include <QskRadioBox.h>
+#include <QskSegmentedBar.h>
+#include <QskSkin.h>
+#include <QskSkinHintTable.h>
+#include <QskSkinManager.h>
+#include <QskSlider.h>
+#include <QskSpinBox.h>
+#include <QskSwitchButton.h>
+#include <QskTextField.h>
+#include <QskTextLabel.h>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QTextStream>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+static std::atomic< quint64 > allocationCounter( 0 );
+
+void* operator new( std::size_t size )
+{
+    allocationCounter.fetch_add( 1, std::memory_order_relaxed );
+
+    if ( auto ptr = std::malloc( size > 0 ? size : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void operator delete( void* ptr ) noexcept
+{
+    std::free( ptr );
+}
+
+void operator delete( void* ptr, std::size_t ) noexcept
+{
+    std::free( ptr );
+}
+
+namespace
+{
+    class Result
+    {
+      public:
+        QString skinName;
+        QString name;
+
+        quint64 lookups = 0;
+        qint64 nsecs = 0;
+        quint64 allocations = 0;
+    };
+
+    class Benchmark
+    {
+      public:
+        Benchmark( int rounds )
+            : m_rounds( rounds )
+        {
+            m_root = new QskControl();
+
+            const auto parent = m_root;
+
+            m_controls += new QskPushButton( "Button", parent );
+            m_controls += new QskCheckBox( "CheckBox", parent );
+            m_controls += new QskComboBox( parent );
+            m_controls += new QskProgressBar( parent );
+            m_controls += new QskRadioBox( { "1", "2", "3" }, parent );
+            m_controls += new QskSegmentedBar( parent );
+            m_controls += new QskSlider( parent );
+            m_controls += new QskSpinBox( parent );
+            m_controls += new QskSwitchButton( parent );
+            m_controls += new QskTextField( "Text", parent );
+            m_controls += new QskTextLabel( "Label", parent );
+        }
+
+        ~Benchmark()
+        {
+            delete m_root;
+        }
+
+        void run( QskSkin* skin )
+        {
+            qskSkinManager->setSkin( skin );
+
+            m_skinName = skin->objectName();
+            m_stateCombinations = stateCombinations( skin->hintTable().states() );
+
+            for ( auto control : std::as_const( m_controls ) )
+                control->setHintCacheEnabled( false );
+
+            runEffectiveSkinHint( "QskSkinnable::effectiveSkinHint" );
+
+            for ( auto control : std::as_const( m_controls ) )
+                control->setHintCacheEnabled( true );
+
+            runEffectiveSkinHint( "QskSkinnable::effectiveSkinHint (hint cache)" );
+
+            for ( auto control : std::as_const( m_controls ) )
+                control->setHintCacheEnabled( false );
+
+            runResolvedHint( skin->hintTable() );
+            runBoxHints();
+        }
+
+        const std::vector< Result >& results() const
+        {
+            return m_results;
+        }
+
+      private:
+        static QVector< QskAspect::States > stateCombinations( QskAspect::States mask )
+        {
+            /*
+                All single states and all pairs of states, that are
+                used in the skin.
+             */
+            QVector< QskAspect::State > states;
+            for ( uint i = 0; i < 16; i++ )
+            {
+                const auto state = static_cast< QskAspect::State >( 1 << i );
+                if ( mask & state )
+                    states += state;
+            }
+
+            QVector< QskAspect::States > combinations;
+            combinations += QskAspect::NoState;
+
+            for ( int i = 0; i < states.count(); i++ )
+            {
+                combinations += states[ i ];
+
+                for ( int j = i + 1; j < states.count(); j++ )
+                    combinations += states[ i ] | states[ j ];
+            }
+
+            return combinations;
+        }
+
+        static const QVector< QskAspect >& hotAspects()
+        {
+            // the hints, that are retrieved for almost every subcontrol
+            using A = QskAspect;
+            const A aspect;
+
+            static const QVector< QskAspect > aspects =
+            {
+                aspect | A::Color,
+                aspect | A::Color | A::Border,
+                aspect | A::Color | A::Shadow,
+                aspect | A::Metric | A::Padding,
+                aspect | A::Metric | A::Margin,
+                aspect | A::Metric | A::Spacing,
+                aspect | A::Metric | A::StrutSize,
+                aspect | A::Metric | A::Shape,
+                aspect | A::Metric | A::Border,
+                aspect | A::Metric | A::Shadow,
+                aspect | A::Alignment,
+                aspect | A::FontRole,
+                aspect | A::GraphicRole
+            };
+
+            return aspects;
+        }
+
+        template< typename Lookup >
+        void measure( const QString& name, Lookup lookup )
+        {
+            Result result;
+            result.skinName = m_skinName;
+            result.name = name;
+
+            // warm up
+            ( void ) lookup();
+
+            const auto allocations = allocationCounter.load();
+
+            QElapsedTimer timer;
+            timer.start();
+
+            for ( int i = 0; i < m_rounds; i++ )
+                result.lookups += lookup();
+
+            result.nsecs = timer.nsecsElapsed();
+            result.allocations = allocationCounter.load() - allocations;
+
+            m_results.push_back( result );
+        }
+
+        void runEffectiveSkinHint( const QString& name )
+        {
+            measure( name, [ this ]()
+            {
+                quint64 count = 0;
+
+                for ( auto control : std::as_const( m_controls ) )
+                {
+                    const auto subControls = control->subControls();
+
+                    for ( const auto states : std::as_const( m_stateCombinations ) )
+                    {
+                        control->setSkinStates( states );
+
+                        for ( const auto subControl : subControls )
+                        {
+                            for ( const auto aspect : hotAspects() )
+                            {
+                                ( void ) control->effectiveSkinHint( subControl | aspect );
+                                count++;
+                            }
+                        }
+                    }
+
+                    control->setSkinStates( QskAspect::NoState );
+                }
+
+                return count;
+            } );
+        }
+
+        void runResolvedHint( const QskSkinHintTable& table )
+        {
+            measure( "QskSkinHintTable::resolvedHint", [ this, &table ]()
+            {
+                quint64 count = 0;
+
+                for ( auto control : std::as_const( m_controls ) )
+                {
+                    const auto subControls = control->subControls();
+
+                    for ( const auto states : std::as_const( m_stateCombinations ) )
+                    {
+                        for ( const auto subControl : subControls )
+                        {
+                            for ( const auto aspect : hotAspects() )
+                            {
+                                ( void ) table.resolvedHint( subControl | aspect | states );
+                                count++;
+                            }
+                        }
+                    }
+                }
+
+                return count;
+            } );
+        }
+
+        void runBoxHints()
+        {
+            measure( "QskSkinnable::boxHints", [ this ]()
+            {
+                quint64 count = 0;
+
+                for ( auto control : std::as_const( m_controls ) )
+                {
+                    const auto subControls = control->subControls();
+
+                    for ( const auto states : std::as_const( m_stateCombinations ) )
+                    {
+                        control->setSkinStates( states );
+
+                        for ( const auto subControl : subControls )
+                        {
+                            ( void ) control->boxHints( subControl );
+                            count++;
+                        }
+                    }
+
+                    control->setSkinStates( QskAspect::NoState );
+                }
+
+                return count;
+            } );
+        }
+
+        const int m_rounds;
+
+        QskControl* m_root;
+        QVector< QskControl* > m_controls;
+
+        QString m_skinName;
+        QVector< QskAspect::States > m_stateCombinations;
+
+        std::vector< Result > m_results;
+    };
+}
+
+static void printResults( const std::vector< Result >& results, bool csv )
+{
+    QTextStream out( stdout );
+
+    if ( csv )
+        out << "skin,benchmark,lookups,nsecs,lookupsPerSecond,allocationsPerLookup\n";
+
+    for ( const auto& result : results )
+    {
+        const double seconds = result.nsecs / 1e9;
+
+        const double lookupsPerSecond =
+            ( seconds > 0.0 ) ? result.lookups / seconds : 0.0;
+
+        const double allocationsPerLookup = ( result.lookups > 0 )
+            ? double( result.allocations ) / result.lookups : 0.0;
+
+        if ( csv )
+        {
+            out << result.skinName << ',' << result.name << ','
+                << result.lookups << ',' << result.nsecs << ','
+                << qRound64( lookupsPerSecond ) << ','
+                << allocationsPerLookup << '\n';
+        }
+        else
+        {
+            out << qSetFieldWidth( 12 ) << Qt::left << result.skinName
+                << qSetFieldWidth( 48 ) << result.name
+                << qSetFieldWidth( 14 ) << Qt::right << qRound64( lookupsPerSecond )
+                << qSetFieldWidth( 0 ) << " lookups/s "
+                << qSetFieldWidth( 8 ) << qSetRealNumberPrecision( 3 )
+                << allocationsPerLookup
+                << qSetFieldWidth( 0 ) << " allocations/lookup\n";
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    int rounds = 100;
+    bool csv = false;
+
+    const auto args = app.arguments();
+    for ( int i = 1; i < args.count(); i++ )
+    {
+        if ( args[ i ] == QLatin1String( "--csv" ) )
+            csv = true;
+        else if ( args[ i ] == QLatin1String( "--rounds" ) && i + 1 < args.count() )
+            rounds = qMax( 1, args[ ++i ].toInt() );
+    }
+
+    // using the skins linked to the benchmark instead of loading plugins
+    qskSkinManager->setPluginPaths( QStringList() );
+    qskSkinManager->setTransitionHint( QskAnimationHint() );
+
+    qskSkinManager->registerFactory( "Fusion", new QskFusionSkinFactory() );
+    qskSkinManager->registerFactory( "Material3", new QskMaterial3SkinFactory() );
+    qskSkinManager->registerFactory( "Fluent2", new QskFluent2SkinFactory() );
+
+    Benchmark benchmark( rounds );
+
+    const auto skinNames = qskSkinManager->skinNames();
+    for ( const auto& skinName : skinNames )
+    {
+        auto skin = qskSkinManager->createSkin( skinName, QskSkin::LightScheme );
+        if ( skin == nullptr )
+            continue;
+
+        benchmark.run( skin );
+
+        // the skin manager deletes the previous skin, when setting another one
+    }
+
+    printResults( benchmark.results(), csv );
+
+    return 0;
+}
@@ -0,0 +1,476 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    A headless benchmark for the layout engines. It can be run
+    without GPU as no window is created:
+
+        layoutbenchmark [ --rounds <n> ] [ --csv ]
+
+    For each of the synthetic trees the calculation of the size hints
+    and the geometries are measured. Layouts are usually done when
+    polishing, what needs a window. So the benchmark calls
+    updateLayout() of all boxes - parents before children - instead.
+
+    The number of calculated layout chains is taken from the chain
+    cache statistics of QskLayoutEngine2D.
+
+    Each benchmark is run twice: with cold caches, where the metrics
+    and the shaped texts of QskTextMetricsCache/QskPlainTextRenderer are
+    dropped before each round, and with warm caches, where only the
+    layouts are invalidated.
+ */
+
+#include <fusion/QskFusionSkinFactory.h>
+
+#include <QskAnimationHint.h>
+#include <QskControl.h>
+#include <QskGridBox.h>
+#include <QskLayoutEngine2D.h>
+#include <QskLinearBox.h>
+#include <QskPlainTextRenderer.h>
+#include <QskSkin.h>
+#include <QskSkinManager.h>
+#include <QskTextLabel.h>
+#include <QskTextMetricsCache.h>
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QTextStream>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace
+{
+    template< typename Box >
+    class BenchmarkBox final : public Box
+    {
+      public:
+        using Box::Box;
+
+        void layoutNow()
+        {
+            this->updateLayout();
+        }
+    };
+
+    using LinearBox = BenchmarkBox< QskLinearBox >;
+    using GridBox = BenchmarkBox< QskGridBox >;
+
+    class Result
+    {
+      public:
+        QString scenario;
+        QString name;
+        bool warm = false;
+
+        int items = 0;
+        int rounds = 0;
+        qint64 nsecs = 0;
+
+        quint64 chainRebuilds = 0;
+        quint64 chainCacheHits = 0;
+
+        quint64 textCacheMisses = 0;
+        quint64 textCacheHits = 0;
+    };
+
+    class Scenario
+    {
+      public:
+        Scenario( const QString& name )
+            : name( name )
+        {
+        }
+
+        ~Scenario()
+        {
+            delete root;
+        }
+
+        template< typename Box >
+        Box* addBox( Box* box )
+        {
+            // boxes have to be created parents first
+            layouters.push_back( [ box ]() { box->layoutNow(); } );
+            invalidators.push_back( [ box ]() { box->invalidate(); } );
+
+            return box;
+        }
+
+        QskControl* addControl( QskControl* control )
+        {
+            itemCount++;
+            return control;
+        }
+
+        void invalidate()
+        {
+            for ( const auto& invalidator : invalidators )
+                invalidator();
+        }
+
+        void layout()
+        {
+            for ( const auto& layouter : layouters )
+                layouter();
+        }
+
+        const QString name;
+
+        QskControl* root = nullptr;
+        int itemCount = 0;
+
+      private:
+        std::vector< std::function< void() > > layouters;
+        std::vector< std::function< void() > > invalidators;
+    };
+
+    QskControl* createItem( const QSizeF& size )
+    {
+        auto control = new QskControl();
+        control->setPreferredSize( size );
+        control->setMinimumSize( 0.5 * size );
+
+        return control;
+    }
+
+    QskTextLabel* createLabel( int index )
+    {
+        static const QString text = QStringLiteral(
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit, "
+            "sed do eiusmod tempor incididunt ut labore et dolore magna aliqua." );
+
+        // different lengths to get different heights
+        auto label = new QskTextLabel( text.left( 20 + ( index * 17 ) % text.length() ) );
+        label->setWrapMode( QskTextOptions::WordWrap );
+
+        return label;
+    }
+
+    Scenario* createDeepScenario( int depth )
+    {
+        /*
+            Boxes of alternating orientation, each one containing
+            a nested box, a text and some fixed items
+         */
+        auto scenario = new Scenario( QStringLiteral( "deep-%1" ).arg( depth ) );
+
+        QskLinearBox* parentBox = nullptr;
+
+        for ( int i = 0; i < depth; i++ )
+        {
+            const auto orientation = ( i % 2 ) ? Qt::Vertical : Qt::Horizontal;
+
+            auto box = scenario->addBox( new LinearBox( orientation ) );
+
+            if ( parentBox )
+            {
+                parentBox->addItem( box );
+                parentBox->setStretchFactor( box, 2 );
+            }
+            else
+            {
+                scenario->root = box;
+            }
+
+            box->addItem( scenario->addControl( createLabel( i ) ) );
+
+            const auto index = box->addItem(
+                scenario->addControl( createItem( QSizeF( 40, 20 ) ) ) );
+            box->setStretchFactor( index, i % 3 );
+
+            box->addStretch( 1 );
+
+            parentBox = box;
+        }
+
+        return scenario;
+    }
+
+    Scenario* createGridScenario( int rows, int columns, bool spans )
+    {
+        auto scenario = new Scenario( QStringLiteral( "grid-%1x%2%3" )
+            .arg( rows ).arg( columns ).arg( spans ? "-spans" : "" ) );
+
+        auto grid = scenario->addBox( new GridBox() );
+        scenario->root = grid;
+
+        for ( int row = 0; row < rows; row++ )
+        {
+            for ( int col = 0; col < columns; col++ )
+            {
+                const QSizeF size( 20 + ( col % 5 ) * 4, 10 + ( row % 3 ) * 4 );
+
+                if ( spans && ( row % 4 == 0 ) && ( col % 4 == 0 ) )
+                {
+                    // a 2x2 item instead of 4 single cells
+                    grid->addItem( scenario->addControl( createItem( 2 * size ) ),
+                        row, col, 2, 2 );
+                }
+                else if ( spans && ( row % 4 <= 1 ) && ( col % 4 <= 1 ) )
+                {
+                    continue; // covered by a span
+                }
+                else
+                {
+                    grid->addItem( scenario->addControl( createItem( size ) ), row, col );
+                }
+            }
+        }
+
+        for ( int col = 0; col < columns; col += 7 )
+            grid->setColumnStretchFactor( col, 1 + col % 3 );
+
+        for ( int row = 0; row < rows; row += 5 )
+            grid->setRowStretchFactor( row, 1 );
+
+        return scenario;
+    }
+
+    Scenario* createTextScenario( int rows, int columns )
+    {
+        /*
+            A vertical box with rows of wrapping texts, what results
+            in heightForWidth requests for all rows.
+         */
+        auto scenario = new Scenario( QStringLiteral( "text-%1x%2" ).arg( rows ).arg( columns ) );
+
+        auto box = scenario->addBox( new LinearBox( Qt::Vertical ) );
+        scenario->root = box;
+
+        for ( int row = 0; row < rows; row++ )
+        {
+            auto rowBox = scenario->addBox( new LinearBox( Qt::Horizontal ) );
+            box->addItem( rowBox );
+
+            for ( int col = 0; col < columns; col++ )
+            {
+                auto label = createLabel( row * columns + col );
+                rowBox->addItem( scenario->addControl( label ) );
+                rowBox->setStretchFactor( label, 1 + col % 2 );
+            }
+        }
+
+        return scenario;
+    }
+
+    class Benchmark
+    {
+      public:
+        Benchmark( int rounds )
+            : m_rounds( rounds )
+        {
+        }
+
+        void run( Scenario* scenario )
+        {
+            m_scenario = scenario;
+            const auto root = scenario->root;
+
+            measure( "sizeHint", [ root ]()
+            {
+                ( void ) root->effectiveSizeHint( Qt::PreferredSize );
+                ( void ) root->effectiveSizeHint( Qt::MinimumSize );
+            } );
+
+            measure( "heightForWidth", [ root ]()
+            {
+                // probing like an enclosing layout does
+                for ( const qreal width : { 300.0, 600.0, 1200.0 } )
+                    ( void ) root->effectiveSizeHint( Qt::PreferredSize, QSizeF( width, -1 ) );
+            } );
+
+            const auto size = root->effectiveSizeHint( Qt::PreferredSize );
+
+            int round = 0;
+            measure( "setGeometries", [ scenario, root, size, &round ]()
+            {
+                // alternating sizes, so that the geometries always change
+                const qreal f = ( round++ % 2 ) ? 1.0 : 1.5;
+
+                root->setGeometry( QRectF( QPointF(), f * size ) );
+                scenario->layout();
+            } );
+        }
+
+        const std::vector< Result >& results() const
+        {
+            return m_results;
+        }
+
+      private:
+        template< typename Operation >
+        void measure( const QString& name, Operation operation )
+        {
+            measure( name, false, operation );
+            measure( name, true, operation );
+        }
+
+        template< typename Operation >
+        void measure( const QString& name, bool warm, Operation operation )
+        {
+            Result result;
+            result.scenario = m_scenario->name;
+            result.name = name;
+            result.warm = warm;
+            result.items = m_scenario->itemCount;
+            result.rounds = m_rounds;
+
+            if ( warm )
+            {
+                // filling the text caches
+                invalidate( false );
+                operation();
+            }
+
+            for ( int i = 0; i < m_rounds; i++ )
+            {
+                invalidate( !warm );
+
+                QskLayoutEngine2D::resetTotalCacheStatistics();
+                QskTextMetricsCache::resetStatistics();
+
+                QElapsedTimer timer;
+                timer.start();
+
+                operation();
+
+                result.nsecs += timer.nsecsElapsed();
+
+                const auto chainStatistics = QskLayoutEngine2D::totalCacheStatistics();
+                result.chainRebuilds += chainStatistics.misses;
+                result.chainCacheHits += chainStatistics.hits;
+
+                const auto textStatistics = QskTextMetricsCache::statistics();
+                result.textCacheMisses += textStatistics.misses;
+                result.textCacheHits += textStatistics.hits;
+            }
+
+            m_results.push_back( result );
+        }
+
+        void invalidate( bool clearTextCaches )
+        {
+            m_scenario->invalidate();
+            QCoreApplication::sendPostedEvents();
+
+            if ( clearTextCaches )
+            {
+                QskTextMetricsCache::clear();
+                QskPlainTextRenderer::clearCache();
+            }
+        }
+
+        const int m_rounds;
+        Scenario* m_scenario = nullptr;
+
+        std::vector< Result > m_results;
+    };
+}
+
+static void printResults( const std::vector< Result >& results, bool csv )
+{
+    QTextStream out( stdout );
+
+    if ( csv )
+    {
+        out << "scenario,benchmark,caches,items,rounds,nsecs,nsecsPerRound,"
+            "chainRebuildsPerRound,chainCacheHitsPerRound,"
+            "textMissesPerRound,textHitsPerRound\n";
+    }
+
+    for ( const auto& result : results )
+    {
+        const auto rounds = qMax( result.rounds, 1 );
+
+        const qint64 nsecsPerRound = result.nsecs / rounds;
+        const double rebuildsPerRound = double( result.chainRebuilds ) / rounds;
+        const double hitsPerRound = double( result.chainCacheHits ) / rounds;
+        const double textMissesPerRound = double( result.textCacheMisses ) / rounds;
+
+        const auto caches = result.warm ? "warm" : "cold";
+
+        if ( csv )
+        {
+            out << result.scenario << ',' << result.name << ',' << caches << ','
+                << result.items << ',' << result.rounds << ','
+                << result.nsecs << ',' << nsecsPerRound << ','
+                << rebuildsPerRound << ',' << hitsPerRound << ','
+                << textMissesPerRound << ','
+                << double( result.textCacheHits ) / rounds << '\n';
+        }
+        else
+        {
+            out << qSetFieldWidth( 20 ) << Qt::left << result.scenario
+                << qSetFieldWidth( 16 ) << result.name
+                << qSetFieldWidth( 6 ) << caches
+                << qSetFieldWidth( 8 ) << Qt::right << result.items
+                << qSetFieldWidth( 0 ) << " items"
+                << qSetFieldWidth( 12 ) << ( nsecsPerRound / 1000 )
+                << qSetFieldWidth( 0 ) << " us/round"
+                << qSetFieldWidth( 10 ) << qSetRealNumberPrecision( 6 )
+                << rebuildsPerRound
+                << qSetFieldWidth( 0 ) << " chains/round"
+                << qSetFieldWidth( 10 ) << hitsPerRound
+                << qSetFieldWidth( 0 ) << " hits/round"
+                << qSetFieldWidth( 10 ) << textMissesPerRound
+                << qSetFieldWidth( 0 ) << " measured texts/round\n";
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    if ( qEnvironmentVariableIsEmpty( "QT_QPA_PLATFORM" ) )
+        qputenv( "QT_QPA_PLATFORM", "offscreen" );
+
+    QGuiApplication app( argc, argv );
+
+    int rounds = 20;
+    bool csv = false;
+
+    const auto args = app.arguments();
+    for ( int i = 1; i < args.count(); i++ )
+    {
+        if ( args[ i ] == QLatin1String( "--csv" ) )
+            csv = true;
+        else if ( args[ i ] == QLatin1String( "--rounds" ) && i + 1 < args.count() )
+            rounds = qMax( 1, args[ ++i ].toInt() );
+    }
+
+    // the metrics of the texts depend on the skin
+    qskSkinManager->setPluginPaths( QStringList() );
+    qskSkinManager->setTransitionHint( QskAnimationHint() );
+    qskSkinManager->registerFactory( "Fusion", new QskFusionSkinFactory() );
+    qskSkinManager->setSkin( qskSkinManager->createSkin( "Fusion", QskSkin::LightScheme ) );
+
+    using CreateScenario = std::function< Scenario*() >;
+
+    const std::vector< CreateScenario > scenarios =
+    {
+        []() { return createDeepScenario( 8 ); },
+        []() { return createDeepScenario( 16 ); },
+        []() { return createGridScenario( 10, 10, false ); },
+        []() { return createGridScenario( 100, 100, false ); },
+        []() { return createGridScenario( 100, 100, true ); },
+        []() { return createTextScenario( 50, 3 ); },
+        []() { return createTextScenario( 200, 5 ); }
+    };
+
+    Benchmark benchmark( rounds );
+
+    for ( const auto& createScenario : scenarios )
+    {
+        std::unique_ptr< Scenario > scenario( createScenario() );
+        benchmark.run( scenario.get() );
+    }
+
+    printResults( benchmark.results(), csv );
+
+    return 0;
+}
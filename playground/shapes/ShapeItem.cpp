@@ -163,6 +163,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
 
     const auto pathRect = m_data->path.controlPointRect();
 
+    const bool async = testUpdateFlag( QskItem::PreferAsynchronousTessellation );
+
     if ( m_data->gradient.isVisible() )
     {
         if ( fillNode == nullptr )
@@ -186,6 +188,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
 #endif
 
         const auto transform = ::transformForRects( pathRect, fillRect );
+
+        fillNode->setHint( QskFillNode::PreferAsynchronousTessellation, async );
         fillNode->updatePath( m_data->path, transform, fillRect, m_data->gradient );
     }
     else
@@ -222,6 +226,8 @@ void ShapeItem::updateNode( QSGNode* parentNode )
         }
 
         const auto transform = ::transformForRects( pathRect, rect );
+
+        borderNode->setHint( QskFillNode::PreferAsynchronousTessellation, async );
         borderNode->updatePath( m_data->path, transform, pen );
     }
     else
@@ -0,0 +1,576 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+/*
+    Checks the vectorized kernels of QskVertex::fillPoints against
+    a scalar implementation and measures both of them:
+
+        vertexbenchmark [ --rounds <n> ] [ --seed <n> ] [ --csv ]
+
+    The results have to be identical bit for bit - including infinities,
+    denormals and the scalar tails of odd counts. Only the sign and
+    payload of NaNs, that result from arithmetic with several NaNs,
+    may differ. The process returns with a non zero exit code on any
+    difference, so that it can be used in CI builds.
+ */
+
+#include <QskVertex.h>
+
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QTransform>
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <random>
+#include <vector>
+
+using QskVertex::Color;
+
+namespace
+{
+    /*
+        The reference implementations: the same operations in the same
+        order as the kernels, followed by a conversion to float.
+     */
+
+    template< typename T >
+    inline void setPoint( QSGGeometry::Point2D& point, T x, T y )
+    {
+        point.x = static_cast< float >( x );
+        point.y = static_cast< float >( y );
+    }
+
+    template< typename T >
+    inline void setPoint( QSGGeometry::ColoredPoint2D& point, T x, T y, Color c )
+    {
+        point.set( static_cast< float >( x ), static_cast< float >( y ),
+            c.r, c.g, c.b, c.a );
+    }
+
+    void referencePoints( int count, const qreal* xy, QSGGeometry::Point2D* points )
+    {
+        for ( int i = 0; i < count; i++ )
+            setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ] );
+    }
+
+    void referencePoints( const QTransform& transform,
+        int count, const qreal* xy, QSGGeometry::Point2D* points )
+    {
+        if ( transform.isIdentity() )
+        {
+            referencePoints( count, xy, points );
+            return;
+        }
+
+        if ( !transform.isAffine() )
+        {
+            // there is no kernel for projective transformations
+            QskVertex::fillPoints( transform, count, xy, points );
+            return;
+        }
+
+        const auto m11 = transform.m11();
+        const auto m12 = transform.m12();
+        const auto m21 = transform.m21();
+        const auto m22 = transform.m22();
+        const auto dx = transform.dx();
+        const auto dy = transform.dy();
+
+        for ( int i = 0; i < count; i++ )
+        {
+            const qreal x = xy[ 2 * i ];
+            const qreal y = xy[ 2 * i + 1 ];
+
+            setPoint( points[i], m11 * x + m21 * y + dx, m12 * x + m22 * y + dy );
+        }
+    }
+
+    void referencePoints( int count, const quint16* indices,
+        const qreal* xy, QSGGeometry::Point2D* points )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            const int j = 2 * indices[i];
+            setPoint( points[i], xy[j], xy[j + 1] );
+        }
+    }
+
+    void referencePoints( int count, const quint16* indices,
+        const qreal* xy, Color color, QSGGeometry::ColoredPoint2D* points )
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            const int j = 2 * indices[i];
+            setPoint( points[i], xy[j], xy[j + 1], color );
+        }
+    }
+
+    void referencePoints( int count, const float* xy,
+        Color color, QSGGeometry::ColoredPoint2D* points )
+    {
+        for ( int i = 0; i < count; i++ )
+            setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ], color );
+    }
+
+    class Input
+    {
+      public:
+        Input( const QString& name )
+            : name( name )
+        {
+        }
+
+        QString name;
+
+        std::vector< qreal > xy;
+        std::vector< float > xyf;
+        std::vector< quint16 > indices;
+    };
+
+    class Generator
+    {
+      public:
+        Generator( quint32 seed )
+            : m_random( seed )
+        {
+        }
+
+        Input random( int count, qreal range )
+        {
+            Input input( QStringLiteral( "random-%1" ).arg( range ) );
+
+            std::uniform_real_distribution< qreal > dist( -range, range );
+
+            input.xy.resize( 2 * count );
+            for ( auto& value : input.xy )
+                value = dist( m_random );
+
+            finalize( input );
+            return input;
+        }
+
+        Input edgeCases( int count )
+        {
+            /*
+                NaNs with payload, infinities, signed zeros, denormals,
+                values beyond the range of float and values, that are
+                exactly in the middle between 2 floats
+             */
+            const qreal nan = std::numeric_limits< qreal >::quiet_NaN();
+            const qreal inf = std::numeric_limits< qreal >::infinity();
+
+            quint64 bits;
+            std::memcpy( &bits, &nan, sizeof( bits ) );
+            bits |= 0x00000123456789abull;
+
+            qreal payloadNaN;
+            std::memcpy( &payloadNaN, &bits, sizeof( payloadNaN ) );
+
+            const qreal values[] =
+            {
+                nan, -nan, payloadNaN, inf, -inf, 0.0, -0.0,
+                std::numeric_limits< qreal >::denorm_min(),
+                std::numeric_limits< qreal >::min(),
+                qreal( std::numeric_limits< float >::denorm_min() ),
+                qreal( std::numeric_limits< float >::max() ),
+                -qreal( std::numeric_limits< float >::max() ),
+                3.5e38, -3.5e38, 1e30, -1e30, 1e300, -1e300,
+                1.0 + std::ldexp( 1.0, -24 ), 1.0 + 3 * std::ldexp( 1.0, -24 ),
+                16777217.0, -16777217.0, 0.1, 1e-30
+            };
+
+            const int valueCount = sizeof( values ) / sizeof( values[0] );
+
+            std::uniform_int_distribution< int > dist( 0, valueCount - 1 );
+
+            Input input( QStringLiteral( "edge-cases" ) );
+
+            input.xy.resize( 2 * count );
+            for ( auto& value : input.xy )
+                value = values[ dist( m_random ) ];
+
+            finalize( input );
+            return input;
+        }
+
+      private:
+        void finalize( Input& input )
+        {
+            const int count = int( input.xy.size() / 2 );
+
+            input.xyf.resize( input.xy.size() );
+            for ( size_t i = 0; i < input.xy.size(); i++ )
+                input.xyf[i] = static_cast< float >( input.xy[i] );
+
+            input.indices.resize( count );
+            if ( count > 0 )
+            {
+                std::uniform_int_distribution< int > dist( 0, count - 1 );
+
+                for ( auto& index : input.indices )
+                    index = quint16( dist( m_random ) );
+            }
+        }
+
+        std::mt19937 m_random;
+    };
+
+    inline bool isEqual( float value1, float value2 )
+    {
+        /*
+            Which NaN operand is propagated by an addition depends on
+            the order of the operands, that might be swapped by the
+            compiler. So sign and payload of a NaN, that results from
+            arithmetic with several NaNs, are not reproducible.
+         */
+        if ( std::isnan( value1 ) && std::isnan( value2 ) )
+            return true;
+
+        return std::memcmp( &value1, &value2, sizeof( float ) ) == 0;
+    }
+
+    inline bool isEqual( const QSGGeometry::Point2D& p1, const QSGGeometry::Point2D& p2 )
+    {
+        return isEqual( p1.x, p2.x ) && isEqual( p1.y, p2.y );
+    }
+
+    inline bool isEqual( const QSGGeometry::ColoredPoint2D& p1,
+        const QSGGeometry::ColoredPoint2D& p2 )
+    {
+        return isEqual( p1.x, p2.x ) && isEqual( p1.y, p2.y )
+            && p1.r == p2.r && p1.g == p2.g && p1.b == p2.b && p1.a == p2.a;
+    }
+
+    template< typename Point >
+    class Buffers
+    {
+      public:
+        Buffers( int count )
+            : count( count )
+            , kernel( count + Guard )
+            , reference( count + Guard )
+        {
+            // both buffers start with the same garbage
+            std::memset( kernel.data(), 0xab, kernel.size() * sizeof( Point ) );
+            std::memset( reference.data(), 0xab, reference.size() * sizeof( Point ) );
+        }
+
+        int firstDifference() const
+        {
+            // including the guard, to detect writing beyond count
+            for ( size_t i = 0; i < kernel.size(); i++ )
+            {
+                if ( !isEqual( kernel[i], reference[i] ) )
+                    return int( i );
+            }
+
+            return -1;
+        }
+
+        enum { Guard = 3 };
+
+        const int count;
+
+        std::vector< Point > kernel;
+        std::vector< Point > reference;
+    };
+
+    class Result
+    {
+      public:
+        QString name;
+
+        int count = 0;
+        int rounds = 0;
+
+        qint64 kernelNsecs = 0;
+        qint64 referenceNsecs = 0;
+    };
+
+    class Checker
+    {
+      public:
+        Checker( QTextStream& out )
+            : m_out( out )
+        {
+        }
+
+        template< typename Point, typename Kernel, typename Reference >
+        void check( const QString& name, int count, Kernel kernel, Reference reference )
+        {
+            Buffers< Point > buffers( count );
+
+            kernel( buffers.kernel.data() );
+            reference( buffers.reference.data() );
+
+            m_checks++;
+
+            const int index = buffers.firstDifference();
+            if ( index >= 0 )
+            {
+                m_failures++;
+
+                m_out << "FAILED: " << name << ", count: " << count
+                    << ", first difference at: " << index
+                    << ( index >= count ? " ( beyond count )" : "" ) << '\n';
+            }
+        }
+
+        int checks() const { return m_checks; }
+        int failures() const { return m_failures; }
+
+      private:
+        QTextStream& m_out;
+
+        int m_checks = 0;
+        int m_failures = 0;
+    };
+
+    template< typename Point >
+    Result measure( const QString& name, int count, int rounds,
+        const std::function< void( Point* ) >& kernel,
+        const std::function< void( Point* ) >& reference )
+    {
+        std::vector< Point > points( count );
+
+        Result result;
+        result.name = name;
+        result.count = count;
+        result.rounds = rounds;
+
+        QElapsedTimer timer;
+
+        timer.start();
+        for ( int i = 0; i < rounds; i++ )
+            kernel( points.data() );
+        result.kernelNsecs = timer.nsecsElapsed();
+
+        timer.start();
+        for ( int i = 0; i < rounds; i++ )
+            reference( points.data() );
+        result.referenceNsecs = timer.nsecsElapsed();
+
+        return result;
+    }
+
+    QList< QTransform > transforms()
+    {
+        QTransform rotated;
+        rotated.rotate( 33.3 );
+        rotated.scale( 1.7, 0.3 );
+        rotated.translate( 13.1, -7.7 );
+
+        return
+        {
+            QTransform(), // identity
+            QTransform::fromTranslate( 0.1, -100.7 ),
+            QTransform::fromScale( 1e-3, 3.3e5 ),
+            rotated,
+            QTransform( 1.0, 0.5, 0.3, 1.0, 1e30, -1e30 ), // sheared
+            QTransform( 1e300, 0.0, 0.0, -1e300, 0.0, 0.0 ),
+            QTransform( 1.0, 0.0, 0.001, 0.0, 1.0, 0.002, 0.0, 0.0, 1.0 ) // projective
+        };
+    }
+
+    const Color colors[] =
+    {
+        Color( 0, 0, 0, 0 ), Color( 255, 128, 1, 254 )
+    };
+}
+
+static int checkKernels( quint32 seed, QTextStream& out )
+{
+    Generator generator( seed );
+    Checker checker( out );
+
+    std::vector< int > counts;
+
+    // all combinations of vector bodies and scalar tails
+    for ( int count = 0; count <= 33; count++ )
+        counts.push_back( count );
+
+    counts.insert( counts.end(), { 255, 256, 257, 1000, 1001 } );
+
+    for ( const int count : counts )
+    {
+        const Input inputs[] =
+        {
+            generator.random( count, 1.0 ),
+            generator.random( count, 1e4 ),
+            generator.random( count, 1e38 ),
+            generator.edgeCases( count )
+        };
+
+        for ( const auto& input : inputs )
+        {
+            using P = QSGGeometry::Point2D;
+            using CP = QSGGeometry::ColoredPoint2D;
+
+            /*
+                The kernels use unaligned loads/stores. Checking with
+                the second element as start address covers different
+                alignments of the input
+             */
+            for ( int offset = 0; offset <= qMin( count, 1 ); offset++ )
+            {
+                const int n = qMax( count - offset, 0 );
+
+                const auto xy = input.xy.data() + 2 * offset;
+                const auto xyf = input.xyf.data() + 2 * offset;
+                const auto indices = input.indices.data() + offset;
+
+                const auto name = [ & ]( const char* kernel )
+                {
+                    return QStringLiteral( "%1( %2, offset %3 )" )
+                        .arg( QString::fromLatin1( kernel ), input.name ).arg( offset );
+                };
+
+                checker.check< P >( name( "points" ), n,
+                    [ = ]( P* points ) { QskVertex::fillPoints( n, xy, points ); },
+                    [ = ]( P* points ) { referencePoints( n, xy, points ); } );
+
+                for ( const auto& transform : transforms() )
+                {
+                    checker.check< P >( name( "transformed" ), n,
+                        [ & ]( P* points )
+                            { QskVertex::fillPoints( transform, n, xy, points ); },
+                        [ & ]( P* points )
+                            { referencePoints( transform, n, xy, points ); } );
+                }
+
+                if ( offset > 0 )
+                {
+                    // the indices refer to the complete input
+                    continue;
+                }
+
+                checker.check< P >( name( "indexed" ), n,
+                    [ = ]( P* points ) { QskVertex::fillPoints( n, indices, xy, points ); },
+                    [ = ]( P* points ) { referencePoints( n, indices, xy, points ); } );
+
+                for ( const auto color : colors )
+                {
+                    checker.check< CP >( name( "indexedColored" ), n,
+                        [ = ]( CP* points )
+                            { QskVertex::fillPoints( n, indices, xy, color, points ); },
+                        [ = ]( CP* points )
+                            { referencePoints( n, indices, xy, color, points ); } );
+
+                    checker.check< CP >( name( "floatColored" ), n,
+                        [ = ]( CP* points )
+                            { QskVertex::fillPoints( n, xyf, color, points ); },
+                        [ = ]( CP* points )
+                            { referencePoints( n, xyf, color, points ); } );
+                }
+            }
+        }
+    }
+
+    out << checker.checks() << " checks, " << checker.failures() << " failures\n";
+    out.flush();
+
+    return checker.failures();
+}
+
+static std::vector< Result > runBenchmarks( quint32 seed, int rounds )
+{
+    using P = QSGGeometry::Point2D;
+    using CP = QSGGeometry::ColoredPoint2D;
+
+    // typical sizes of the geometries of shapes and strokes
+    const int count = 10000;
+
+    Generator generator( seed );
+    const auto input = generator.random( count, 1e3 );
+
+    const auto xy = input.xy.data();
+    const auto xyf = input.xyf.data();
+    const auto indices = input.indices.data();
+
+    const auto transform = transforms()[3];
+    const Color color( 255, 128, 1, 254 );
+
+    std::vector< Result > results;
+
+    results.push_back( measure< P >( "points", count, rounds,
+        [ = ]( P* points ) { QskVertex::fillPoints( count, xy, points ); },
+        [ = ]( P* points ) { referencePoints( count, xy, points ); } ) );
+
+    results.push_back( measure< P >( "transformed", count, rounds,
+        [ & ]( P* points ) { QskVertex::fillPoints( transform, count, xy, points ); },
+        [ & ]( P* points ) { referencePoints( transform, count, xy, points ); } ) );
+
+    results.push_back( measure< P >( "indexed", count, rounds,
+        [ = ]( P* points ) { QskVertex::fillPoints( count, indices, xy, points ); },
+        [ = ]( P* points ) { referencePoints( count, indices, xy, points ); } ) );
+
+    results.push_back( measure< CP >( "indexedColored", count, rounds,
+        [ = ]( CP* points ) { QskVertex::fillPoints( count, indices, xy, color, points ); },
+        [ = ]( CP* points ) { referencePoints( count, indices, xy, color, points ); } ) );
+
+    results.push_back( measure< CP >( "floatColored", count, rounds,
+        [ = ]( CP* points ) { QskVertex::fillPoints( count, xyf, color, points ); },
+        [ = ]( CP* points ) { referencePoints( count, xyf, color, points ); } ) );
+
+    return results;
+}
+
+static void printResults( const std::vector< Result >& results, bool csv, QTextStream& out )
+{
+    if ( csv )
+        out << "benchmark,count,rounds,kernelNsecs,referenceNsecs\n";
+
+    for ( const auto& result : results )
+    {
+        const auto rounds = qMax( result.rounds, 1 );
+
+        if ( csv )
+        {
+            out << result.name << ',' << result.count << ',' << result.rounds << ','
+                << result.kernelNsecs << ',' << result.referenceNsecs << '\n';
+        }
+        else
+        {
+            out << qSetFieldWidth( 16 ) << Qt::left << result.name
+                << qSetFieldWidth( 8 ) << Qt::right << result.count
+                << qSetFieldWidth( 0 ) << " points"
+                << qSetFieldWidth( 12 ) << ( result.kernelNsecs / rounds )
+                << qSetFieldWidth( 0 ) << " ns/round"
+                << qSetFieldWidth( 12 ) << ( result.referenceNsecs / rounds )
+                << qSetFieldWidth( 0 ) << " ns/round ( scalar )\n";
+        }
+    }
+}
+
+int main( int argc, char* argv[] )
+{
+    int rounds = 1000;
+    quint32 seed = 4711;
+    bool csv = false;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const auto arg = QString::fromLocal8Bit( argv[i] );
+
+        if ( arg == QLatin1String( "--csv" ) )
+            csv = true;
+        else if ( arg == QLatin1String( "--rounds" ) && i + 1 < argc )
+            rounds = qMax( 1, QString::fromLocal8Bit( argv[ ++i ] ).toInt() );
+        else if ( arg == QLatin1String( "--seed" ) && i + 1 < argc )
+            seed = QString::fromLocal8Bit( argv[ ++i ] ).toUInt();
+    }
+
+    QTextStream out( stdout );
+
+    if ( checkKernels( seed, out ) > 0 )
+        return 1;
+
+    printResults( runBenchmarks( seed, rounds ), csv, out );
+
+    return 0;
+}
@@ -743,6 +743,8 @@ bool QskControl::event( QEvent* event )
         {
             // The skin has changed
 
+            invalidateHintCache();
+
             if ( skinlet() == nullptr )
             {
                 /*
@@ -11,6 +11,7 @@
 #include "QskSkinManager.h"
 #include "QskSkin.h"
 #include "QskDirtyItemFilter.h"
+#include "QskTessellationMonitor.h"
 #include "QskInternalMacros.h"
 
 #include <qglobalstatic.h>
@@ -81,6 +82,16 @@ namespace
 
             QObject::connect( qskSkinManager, &QskSkinManager::colorSchemeChanged,
                 qskSkinManager, [ this ] { updateSkin(); } );
+
+            /*
+                The signal is emitted from a worker thread and does not
+                tell which nodes have been waiting. So all items, that
+                might have asynchronous tessellations, are updated.
+             */
+            QObject::connect( qskTessellationMonitor,
+                &QskTessellationMonitor::tessellationFinished,
+                qskSkinManager, [ this ] { updateTessellatingItems(); },
+                Qt::QueuedConnection );
         }
 
         inline void insert( QskItem* item )
@@ -112,6 +123,18 @@ namespace
             }
         }
 
+        void updateTessellatingItems()
+        {
+            for ( auto item : m_items )
+            {
+                if ( ( item->flags() & QQuickItem::ItemHasContents )
+                    && item->testUpdateFlag( QskItem::PreferAsynchronousTessellation ) )
+                {
+                    item->update();
+                }
+            }
+        }
+
       private:
         std::unordered_set< QskItem* > m_items;
     };
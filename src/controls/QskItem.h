@@ -55,8 +55,12 @@ class QSK_EXPORT QskItem : public QQuickItem
         CleanupOnVisibility     =  1 << 3,
 
         PreferRasterForTextures =  1 << 4,
+        PreferAsynchronousPainting = 1 << 5,
+        PreferGeometryForGraphics = 1 << 6,
 
-        DebugForceBackground    =  1 << 7
+        DebugForceBackground    =  1 << 7,
+
+        PreferAsynchronousTessellation = 1 << 8
     };
 
     Q_ENUM( UpdateFlag )
@@ -76,8 +76,8 @@ void QskItemPrivate::applyUpdateFlags( QskItem::UpdateFlags flags )
 
     Q_Q( QskItem );
 
-    Q_STATIC_ASSERT( sizeof( updateFlags ) == 1 );
-    for ( uint i = 0; i < 8; i++ )
+    Q_STATIC_ASSERT( sizeof( updateFlags ) == 2 );
+    for ( uint i = 0; i < 16; i++ )
     {
         const auto flag = static_cast< QskItem::UpdateFlag >( 1 << i );
 
@@ -52,8 +52,8 @@ class QskItemPrivate : public QQuickItemPrivate
   private:
     Q_DECLARE_PUBLIC( QskItem )
 
-    quint8 updateFlags;
-    quint8 updateFlagsMask;
+    quint16 updateFlags;
+    quint16 updateFlagsMask;
 
     bool polishOnResize : 1;
     bool polishOnParentResize : 1;
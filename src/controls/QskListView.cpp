@@ -22,16 +22,203 @@ QSK_STATE( QskListView, Selected, QskAspect::FirstUserState )
 
 #define FOCUS_ON_CURRENT 1
 
+namespace
+{
+    /*
+        Individual row heights, organized as Fenwick tree, so that the
+        position of a row and the row at a position can be found in O(log n).
+
+        Rows without an individual height are counted separately, so that
+        changing the default height does not require any updates.
+     */
+    class RowHeights
+    {
+      public:
+        inline bool isEmpty() const
+        {
+            return m_heights.isEmpty();
+        }
+
+        inline int count() const
+        {
+            return m_heights.size();
+        }
+
+        void clear()
+        {
+            m_heights.clear();
+            m_sums.clear();
+            m_counts.clear();
+        }
+
+        inline qreal height( int row, qreal defaultHeight ) const
+        {
+            if ( row < m_heights.size() && m_heights[ row ] >= 0.0 )
+                return m_heights[ row ];
+
+            return defaultHeight;
+        }
+
+        void setHeight( int row, qreal height )
+        {
+            // a negative height resets to the default height
+
+            while ( m_heights.size() <= row )
+                append( -1.0 );
+
+            const auto oldHeight = m_heights[ row ];
+            if ( oldHeight == height || ( oldHeight < 0.0 && height < 0.0 ) )
+                return;
+
+            m_heights[ row ] = height;
+
+            const auto dh = qMax( height, qreal( 0.0 ) ) - qMax( oldHeight, qreal( 0.0 ) );
+            const int dc = ( height >= 0.0 ) - ( oldHeight >= 0.0 );
+
+            for ( int i = row + 1; i <= m_heights.size(); i += i & -i )
+            {
+                m_sums[ i ] += dh;
+                m_counts[ i ] += dc;
+            }
+        }
+
+        void insert( int row, int count )
+        {
+            if ( row >= m_heights.size() || count <= 0 )
+                return;
+
+            m_heights.insert( qMax( row, 0 ), count, -1.0 );
+            rebuild();
+        }
+
+        void remove( int row, int count )
+        {
+            row = qMax( row, 0 );
+            count = qMin( count, m_heights.size() - row );
+
+            if ( count <= 0 )
+                return;
+
+            m_heights.remove( row, count );
+            rebuild();
+        }
+
+        qreal position( int row, qreal defaultHeight ) const
+        {
+            const int n = qMin( row, m_heights.size() );
+
+            qreal sum = 0.0;
+            int count = 0;
+
+            for ( int i = n; i > 0; i -= i & -i )
+            {
+                sum += m_sums[ i ];
+                count += m_counts[ i ];
+            }
+
+            return sum + ( row - count ) * defaultHeight;
+        }
+
+        int rowAt( qreal y, qreal defaultHeight ) const
+        {
+            const int n = m_heights.size();
+
+            int step = 1;
+            while ( 2 * step <= n )
+                step *= 2;
+
+            // descending the tree to the last row, that ends before y
+
+            int row = 0;
+            qreal pos = 0.0;
+
+            for ( ; step > 0; step /= 2 )
+            {
+                const int i = row + step;
+                if ( i <= n )
+                {
+                    const auto h = m_sums[ i ] + ( step - m_counts[ i ] ) * defaultHeight;
+                    if ( pos + h <= y )
+                    {
+                        row = i;
+                        pos += h;
+                    }
+                }
+            }
+
+            if ( row == n && defaultHeight > 0.0 )
+                row += qFloor( ( y - pos ) / defaultHeight );
+
+            return row;
+        }
+
+      private:
+        void append( qreal height )
+        {
+            m_heights += height;
+
+            if ( m_sums.isEmpty() )
+            {
+                m_sums += 0.0;
+                m_counts += 0;
+            }
+
+            const int i = m_heights.size();
+
+            qreal sum = qMax( height, qreal( 0.0 ) );
+            int count = ( height >= 0.0 ) ? 1 : 0;
+
+            // adding the nodes, that are covered by the new one
+            for ( int j = i - 1; j > i - ( i & -i ); j -= j & -j )
+            {
+                sum += m_sums[ j ];
+                count += m_counts[ j ];
+            }
+
+            m_sums += sum;
+            m_counts += count;
+        }
+
+        void rebuild()
+        {
+            const int n = m_heights.size();
+
+            m_sums.fill( 0.0, n + 1 );
+            m_counts.fill( 0, n + 1 );
+
+            for ( int i = 1; i <= n; i++ )
+            {
+                const auto h = m_heights[ i - 1 ];
+                if ( h >= 0.0 )
+                {
+                    m_sums[ i ] += h;
+                    m_counts[ i ]++;
+                }
+
+                const int j = i + ( i & -i );
+                if ( j <= n )
+                {
+                    m_sums[ j ] += m_sums[ i ];
+                    m_counts[ j ] += m_counts[ i ];
+                }
+            }
+        }
+
+        QVector< qreal > m_heights; // < 0: default height
+
+        // 1-based Fenwick trees
+        QVector< qreal > m_sums;
+        QVector< int > m_counts;
+    };
+}
+
 static inline int qskRowAt( const QskListView* listView, const QPointF& pos )
 {
     const auto rect = listView->viewContentsRect();
     if ( rect.contains( pos ) )
     {
         const auto y = pos.y() - rect.top() + listView->scrollPos().y();
-
-        const int row = y / listView->rowHeight();
-        if ( row >= 0 && row < listView->rowCount() )
-            return row;
+        return listView->rowAt( y );
     }
 
     return -1;
@@ -95,6 +282,8 @@ class QskListView::PrivateData
     int hoveredRow = -1;
     int pressedRow = -1;
     int selectedRow = -1;
+
+    RowHeights rowHeights;
 };
 
 QskListView::QskListView( QQuickItem* parent )
@@ -281,7 +470,7 @@ void QskListView::keyPressEvent( QKeyEvent* event )
     {
         auto pos = scrollPos();
 
-        const qreal rowPos = row * rowHeight();
+        const qreal rowPos = rowPosition( row );
         if ( rowPos < scrollPos().y() )
         {
             pos.setY( rowPos );
@@ -289,11 +478,12 @@ void QskListView::keyPressEvent( QKeyEvent* event )
         else
         {
             const QRectF vr = viewContentsRect();
+            const auto rowHeight = rowHeightAt( row );
 
             const double scrolledBottom = scrollPos().y() + vr.height();
-            if ( rowPos + rowHeight() > scrolledBottom )
+            if ( rowPos + rowHeight > scrolledBottom )
             {
-                const double y = rowPos + rowHeight() - vr.height();
+                const double y = rowPos + rowHeight - vr.height();
                 pos.setY( y );
             }
         }
@@ -377,6 +567,97 @@ void QskListView::changeEvent( QEvent* event )
     Inherited::changeEvent( event );
 }
 
+void QskListView::setRowHeightAt( int row, qreal height )
+{
+    if ( row < 0 || row >= rowCount() )
+        return;
+
+    const auto oldHeight = rowHeightAt( row );
+
+    m_data->rowHeights.setHeight( row, qMax( height, qreal( 0.0 ) ) );
+
+    if ( rowHeightAt( row ) != oldHeight )
+    {
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeightAt( int row )
+{
+    if ( row < 0 || row >= m_data->rowHeights.count() )
+        return;
+
+    const auto oldHeight = rowHeightAt( row );
+
+    m_data->rowHeights.setHeight( row, -1.0 );
+
+    if ( rowHeightAt( row ) != oldHeight )
+    {
+        updateScrollableSize();
+        update();
+    }
+}
+
+void QskListView::resetRowHeights()
+{
+    if ( !m_data->rowHeights.isEmpty() )
+    {
+        m_data->rowHeights.clear();
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+bool QskListView::hasVariableRowHeights() const
+{
+    return !m_data->rowHeights.isEmpty();
+}
+
+qreal QskListView::rowHeightAt( int row ) const
+{
+    return m_data->rowHeights.height( row, rowHeight() );
+}
+
+qreal QskListView::rowPosition( int row ) const
+{
+    if ( m_data->rowHeights.isEmpty() )
+        return row * rowHeight();
+
+    return m_data->rowHeights.position( row, rowHeight() );
+}
+
+int QskListView::rowAt( qreal y ) const
+{
+    if ( y < 0.0 )
+        return -1;
+
+    int row;
+
+    if ( m_data->rowHeights.isEmpty() )
+    {
+        const auto h = rowHeight();
+        row = ( h > 0.0 ) ? qFloor( y / h ) : -1;
+    }
+    else
+    {
+        row = m_data->rowHeights.rowAt( y, rowHeight() );
+    }
+
+    return ( row >= 0 && row < rowCount() ) ? row : -1;
+}
+
+void QskListView::insertRowHeights( int row, int count )
+{
+    m_data->rowHeights.insert( row, count );
+}
+
+void QskListView::removeRowHeights( int row, int count )
+{
+    m_data->rowHeights.remove( row, count );
+}
+
 QskAspect::States QskListView::rowStates( int row ) const
 {
     auto states = skinStates();
@@ -398,19 +679,29 @@ QskAspect::States QskListView::rowStates( int row ) const
 
 #ifndef QT_NO_WHEELEVENT
 
-static qreal qskAlignedToRows( const qreal y0, qreal dy,
-    qreal rowHeight, qreal viewHeight )
+static qreal qskAlignedToRows( const QskListView* listView,
+    const qreal y0, qreal dy, qreal viewHeight )
 {
     qreal y = y0 - dy;
 
     if ( dy > 0 )
     {
-        y = qFloor( y / rowHeight ) * rowHeight;
+        const int row = listView->rowAt( y );
+        if ( row >= 0 )
+            y = listView->rowPosition( row );
     }
     else
     {
         y += viewHeight;
-        y = qCeil( y / rowHeight ) * rowHeight;
+
+        const int row = listView->rowAt( y );
+        if ( row >= 0 )
+        {
+            const auto rowPos = listView->rowPosition( row );
+            if ( rowPos < y )
+                y = rowPos + listView->rowHeightAt( row );
+        }
+
         y -= viewHeight;
     }
 
@@ -457,7 +748,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
         dy *= offset.y(); // multiplied by the wheelsteps
 
         // aligning rows that enter the view
-        dy = qskAlignedToRows( y0, dy, rowHeight, viewHeight );
+        dy = qskAlignedToRows( this, y0, dy, viewHeight );
 
         offset.setY( y0 - dy );
     }
@@ -471,7 +762,7 @@ QPointF QskListView::scrollOffset( const QWheelEvent* event ) const
 
 void QskListView::updateScrollableSize()
 {
-    const double h = rowCount() * rowHeight();
+    const double h = rowPosition( rowCount() );
 
     qreal w = 0.0;
     for ( int col = 0; col < columnCount(); col++ )
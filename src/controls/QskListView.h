@@ -62,6 +62,23 @@ class QSK_EXPORT QskListView : public QskScrollView
     virtual qreal columnWidth( int col ) const = 0;
     virtual qreal rowHeight() const = 0;
 
+    /*
+        Individual heights for rows, that differ from rowHeight().
+        The positions of the rows are maintained in a prefix sum tree,
+        so that finding the visible rows remains cheap for large lists.
+     */
+    void setRowHeightAt( int row, qreal height );
+    void resetRowHeightAt( int row );
+    void resetRowHeights();
+
+    bool hasVariableRowHeights() const;
+
+    qreal rowHeightAt( int row ) const;
+    qreal rowPosition( int row ) const;
+
+    // the row at a vertical position of the scrollable area, or -1
+    int rowAt( qreal y ) const;
+
     Q_INVOKABLE virtual QVariant valueAt( int row, int col ) const = 0;
 
     QRectF focusIndicatorRect() const override;
@@ -96,6 +113,10 @@ class QSK_EXPORT QskListView : public QskScrollView
 
     void updateScrollableSize();
 
+    // keeping individual row heights in sync with insertions/removals
+    void insertRowHeights( int row, int count );
+    void removeRowHeights( int row, int count );
+
     void componentComplete() override;
 
   private:
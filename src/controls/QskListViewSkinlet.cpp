@@ -13,7 +13,6 @@
 #include "QskSkinStateChanger.h"
 #include "QskQuick.h"
 
-#include <qmath.h>
 #include <qsgnode.h>
 #include <qtransform.h>
 
@@ -110,15 +109,16 @@ namespace
             setMatrix( QTransform::fromTranslate( -scrollPos.x(), -scrollPos.y() ) );
 
             m_clipRect = listView->viewContentsRect();
-            m_rowHeight = listView->rowHeight();
 
-            m_rowMin = qFloor( scrollPos.y() / m_rowHeight );
+            const int rowCount = listView->rowCount();
 
-            const auto rowMax = ( scrollPos.y() + m_clipRect.height() ) / m_rowHeight;
-            m_rowMax = qFloor( rowMax - 10e-6 );
+            m_rowMin = listView->rowAt( qMax( scrollPos.y(), qreal( 0.0 ) ) );
+            if ( m_rowMin < 0 )
+                m_rowMin = rowCount;
 
-            if ( m_rowMax >= listView->rowCount() )
-                m_rowMax = listView->rowCount() - 1;
+            m_rowMax = listView->rowAt( scrollPos.y() + m_clipRect.height() - 10e-6 );
+            if ( m_rowMax < 0 )
+                m_rowMax = rowCount - 1;
         }
 
         QRectF clipRect() const { return m_clipRect; }
@@ -127,8 +127,6 @@ namespace
         int rowMax() const { return m_rowMax; }
         int rowCount() const { return m_rowMax - m_rowMin + 1; }
 
-        int rowHeight() const { return m_rowHeight; }
-
         QSGNode* backgroundNode() { return &m_backgroundNode; }
         ForegroundNode* foregroundNode() { return &m_foregroundNode; }
 
@@ -136,7 +134,6 @@ namespace
         // caching some calculations to speed things up
 
         QRectF m_clipRect;
-        qreal m_rowHeight;
 
         int m_rowMin, m_rowMax;
 
@@ -250,8 +247,7 @@ void QskListViewSkinlet::updateForegroundNodes(
     // finally putting the nodes into their position
     auto node = foregroundNode->firstChild();
 
-    const auto rowHeight = listView->rowHeight();
-    auto y = clipRect.top() + rowMin * rowHeight;
+    auto y = clipRect.top() + listView->rowPosition( rowMin );
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
@@ -269,7 +265,7 @@ void QskListViewSkinlet::updateForegroundNodes(
             x += listView->columnWidth( col );
         }
 
-        y += rowHeight;
+        y += listView->rowHeightAt( row );
     }
 }
 
@@ -281,7 +277,7 @@ void QskListViewSkinlet::updateVisibleForegroundNodes(
 
     for ( int row = rowMin; row <= rowMax; row++ )
     {
-        const auto h = listView->rowHeight() - ( margins.top() + margins.bottom() );
+        const auto h = listView->rowHeightAt( row ) - ( margins.top() + margins.bottom() );
 
         for ( int col = 0; col < listView->columnCount(); col++ )
         {
@@ -480,9 +476,9 @@ QRectF QskListViewSkinlet::sampleRect( const QskSkinnable* skinnable,
         const auto clipRect = node ? node->clipRect() : listView->viewContentsRect();
 
         const auto w = clipRect.width();
-        const auto h = listView->rowHeight();
+        const auto h = listView->rowHeightAt( index );
         const auto x = clipRect.left() + listView->scrollPos().x();
-        const auto y = clipRect.top() + index * h;
+        const auto y = clipRect.top() + listView->rowPosition( index );
 
         return QRectF( x, y, w, h );
     }
@@ -0,0 +1,393 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskModelListView.h"
+#include "QskEvent.h"
+
+#include <qabstractitemmodel.h>
+#include <qpointer.h>
+#include <qsize.h>
+#include <qvector.h>
+
+class QskModelListView::PrivateData
+{
+  public:
+    QPointer< QAbstractItemModel > model;
+    QVector< QMetaObject::Connection > connections;
+
+    QVector< qreal > columnWidthHints;
+
+    int displayRole = Qt::DisplayRole;
+    int prefetchRows = 20;
+
+    // cached, as rowCount() is called very often from the skinlet
+    int rowCount = 0;
+    int columnCount = 0;
+};
+
+QskModelListView::QskModelListView( QQuickItem* parent )
+    : QskModelListView( nullptr, parent )
+{
+}
+
+QskModelListView::QskModelListView( QAbstractItemModel* model, QQuickItem* parent )
+    : Inherited( parent )
+    , m_data( new PrivateData() )
+{
+    connect( this, &QskScrollBox::scrollPosChanged,
+        this, &QskModelListView::fetchMore );
+
+    setModel( model );
+}
+
+QskModelListView::~QskModelListView()
+{
+}
+
+void QskModelListView::setModel( QAbstractItemModel* model )
+{
+    if ( model == m_data->model )
+        return;
+
+    for ( const auto& connection : std::as_const( m_data->connections ) )
+        disconnect( connection );
+
+    m_data->connections.clear();
+    m_data->model = model;
+
+    if ( model )
+    {
+        using M = QAbstractItemModel;
+        using V = QskModelListView;
+
+        auto& c = m_data->connections;
+
+        c += connect( model, &M::dataChanged, this, &V::onDataChanged );
+
+        c += connect( model, &M::rowsInserted, this, &V::onRowsInserted );
+        c += connect( model, &M::rowsRemoved, this, &V::onRowsRemoved );
+        c += connect( model, &M::rowsMoved, this, &V::onRowsMoved );
+
+        c += connect( model, &M::columnsInserted, this, &V::updateColumns );
+        c += connect( model, &M::columnsRemoved, this, &V::updateColumns );
+        c += connect( model, &M::columnsMoved, this, &V::updateColumns );
+
+        c += connect( model, &M::modelReset, this, &V::resetModel );
+        c += connect( model, &M::layoutChanged, this, &V::resetModel );
+        c += connect( model, &QObject::destroyed, this, &V::resetModel );
+    }
+
+    resetModel();
+
+    Q_EMIT modelChanged();
+}
+
+QAbstractItemModel* QskModelListView::model() const
+{
+    return m_data->model;
+}
+
+void QskModelListView::setDisplayRole( int role )
+{
+    if ( role != m_data->displayRole )
+    {
+        m_data->displayRole = role;
+        update();
+
+        Q_EMIT displayRoleChanged();
+    }
+}
+
+int QskModelListView::displayRole() const
+{
+    return m_data->displayRole;
+}
+
+void QskModelListView::setPrefetchRows( int rows )
+{
+    rows = qMax( rows, 0 );
+
+    if ( rows != m_data->prefetchRows )
+    {
+        m_data->prefetchRows = rows;
+        fetchMore();
+
+        Q_EMIT prefetchRowsChanged();
+    }
+}
+
+int QskModelListView::prefetchRows() const
+{
+    return m_data->prefetchRows;
+}
+
+void QskModelListView::setColumnWidthHint( int column, qreal width )
+{
+    if ( column < 0 )
+        return;
+
+    auto& hints = m_data->columnWidthHints;
+
+    if ( column >= hints.size() )
+    {
+        if ( width <= 0.0 )
+            return;
+
+        hints.resize( column + 1 );
+    }
+
+    width = qMax( width, qreal( 0.0 ) );
+
+    if ( width != hints[ column ] )
+    {
+        hints[ column ] = width;
+
+        updateScrollableSize();
+        update();
+    }
+}
+
+qreal QskModelListView::columnWidthHint( int column ) const
+{
+    const auto& hints = m_data->columnWidthHints;
+
+    if ( column >= 0 && column < hints.size() )
+        return hints[ column ];
+
+    return 0.0;
+}
+
+int QskModelListView::rowCount() const
+{
+    return m_data->rowCount;
+}
+
+int QskModelListView::columnCount() const
+{
+    return m_data->columnCount;
+}
+
+qreal QskModelListView::columnWidth( int col ) const
+{
+    if ( col < 0 || col >= m_data->columnCount )
+        return 0.0;
+
+    qreal w = columnWidthHint( col );
+
+    if ( w <= 0.0 )
+    {
+        /*
+            The texts of a large model can't be measured, so we
+            use the size hint of the header or a width, that
+            is derived from the font.
+         */
+        const auto hint = m_data->model->headerData(
+            col, Qt::Horizontal, Qt::SizeHintRole );
+
+        if ( hint.canConvert< QSizeF >() )
+            w = hint.toSizeF().width();
+
+        if ( w <= 0.0 )
+            w = 10 * effectiveFontHeight( Text );
+    }
+
+    const auto padding = paddingHint( Cell );
+    return w + padding.left() + padding.right();
+}
+
+qreal QskModelListView::rowHeight() const
+{
+    const auto hint = strutSizeHint( Cell );
+    const auto padding = paddingHint( Cell );
+
+    qreal h = effectiveFontHeight( Text );
+    h += padding.top() + padding.bottom();
+
+    return qMax( h, hint.height() );
+}
+
+QVariant QskModelListView::valueAt( int row, int col ) const
+{
+    const auto model = m_data->model.data();
+
+    if ( model == nullptr || row < 0 || row >= m_data->rowCount
+        || col < 0 || col >= m_data->columnCount )
+    {
+        return QVariant();
+    }
+
+    const auto value = model->data( model->index( row, col ), m_data->displayRole );
+
+    // the skinlet supports strings and graphics only
+    return value.isValid() ? value : QVariant( QString() );
+}
+
+void QskModelListView::geometryChangeEvent( QskGeometryChangeEvent* event )
+{
+    Inherited::geometryChangeEvent( event );
+
+    if ( event->isResized() )
+        fetchMore();
+}
+
+void QskModelListView::resetModel()
+{
+    const auto model = m_data->model.data();
+
+    m_data->rowCount = model ? model->rowCount() : 0;
+    m_data->columnCount = model ? model->columnCount() : 0;
+
+    resetRowHeights();
+    setSelectedRow( -1 );
+
+    updateScrollableSize();
+    update();
+
+    fetchMore();
+}
+
+void QskModelListView::updateColumns()
+{
+    const auto model = m_data->model.data();
+    m_data->columnCount = model ? model->columnCount() : 0;
+
+    updateScrollableSize();
+    update();
+}
+
+void QskModelListView::fetchMore()
+{
+    const auto model = m_data->model.data();
+    if ( model == nullptr || !model->canFetchMore( QModelIndex() ) )
+        return;
+
+    const auto vr = viewContentsRect();
+
+    int lastRow = rowAt( scrollPos().y() + vr.height() );
+    if ( lastRow < 0 )
+        lastRow = m_data->rowCount - 1;
+
+    if ( lastRow + m_data->prefetchRows >= m_data->rowCount - 1 )
+        model->fetchMore( QModelIndex() ); // results in rowsInserted
+}
+
+bool QskModelListView::isRowRangeVisible( int first, int last ) const
+{
+    const auto y = scrollPos().y();
+    const auto vr = viewContentsRect();
+
+    int rowMin = rowAt( y );
+    if ( rowMin < 0 )
+        rowMin = m_data->rowCount;
+
+    int rowMax = rowAt( y + vr.height() );
+    if ( rowMax < 0 )
+        rowMax = m_data->rowCount - 1;
+
+    rowMin -= m_data->prefetchRows;
+    rowMax += m_data->prefetchRows;
+
+    return ( first <= rowMax ) && ( last >= rowMin );
+}
+
+void QskModelListView::onDataChanged(
+    const QModelIndex& topLeft, const QModelIndex& bottomRight )
+{
+    if ( topLeft.parent().isValid() )
+        return;
+
+    // the nodes of unchanged cells are not touched by the skinlet
+    if ( isRowRangeVisible( topLeft.row(), bottomRight.row() ) )
+        update();
+}
+
+void QskModelListView::onRowsInserted(
+    const QModelIndex& parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    const int count = last - first + 1;
+
+    m_data->rowCount += count;
+    insertRowHeights( first, count );
+
+    const int row = selectedRow();
+    if ( row >= first )
+        setSelectedRow( row + count );
+
+    updateScrollableSize();
+
+    // all rows below first have moved
+    if ( isRowRangeVisible( first, m_data->rowCount ) )
+        update();
+}
+
+void QskModelListView::onRowsRemoved(
+    const QModelIndex& parent, int first, int last )
+{
+    if ( parent.isValid() )
+        return;
+
+    const int count = last - first + 1;
+
+    // all rows below first have moved
+    const bool isAffected = isRowRangeVisible( first, m_data->rowCount );
+
+    m_data->rowCount -= count;
+    removeRowHeights( first, count );
+
+    const int row = selectedRow();
+    if ( row > last )
+        setSelectedRow( row - count );
+    else if ( row >= first )
+        setSelectedRow( -1 );
+
+    updateScrollableSize();
+
+    if ( isAffected )
+        update();
+
+    fetchMore();
+}
+
+void QskModelListView::onRowsMoved( const QModelIndex& sourceParent,
+    int first, int last, const QModelIndex& destinationParent, int destinationRow )
+{
+    if ( sourceParent.isValid() || destinationParent.isValid() )
+        return;
+
+    const int count = last - first + 1;
+
+    // individual heights of the moved rows are lost
+    removeRowHeights( first, count );
+
+    const int to = ( destinationRow > first ) ? destinationRow - count : destinationRow;
+    insertRowHeights( to, count );
+
+    int row = selectedRow();
+    if ( row >= first && row <= last )
+    {
+        row += to - first;
+    }
+    else
+    {
+        if ( row > last )
+            row -= count;
+
+        if ( row >= to )
+            row += count;
+    }
+
+    if ( row != selectedRow() )
+        setSelectedRow( row );
+
+    updateScrollableSize();
+
+    if ( isRowRangeVisible( qMin( first, to ), qMax( last, to + count - 1 ) ) )
+        update();
+}
+
+#include "moc_QskModelListView.cpp"
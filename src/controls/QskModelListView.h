@@ -0,0 +1,92 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_MODEL_LIST_VIEW_H
+#define QSK_MODEL_LIST_VIEW_H
+
+#include "QskListView.h"
+
+class QAbstractItemModel;
+class QModelIndex;
+
+/*
+    A list view, that displays the rows of a QAbstractItemModel without
+    copying its data. Changes of the model are processed incrementally:
+    changes of rows, that are not visible, do not trigger any updates
+    of the scene graph.
+ */
+class QSK_EXPORT QskModelListView : public QskListView
+{
+    Q_OBJECT
+
+    Q_PROPERTY( QAbstractItemModel* model READ model
+        WRITE setModel NOTIFY modelChanged FINAL )
+
+    Q_PROPERTY( int displayRole READ displayRole
+        WRITE setDisplayRole NOTIFY displayRoleChanged FINAL )
+
+    Q_PROPERTY( int prefetchRows READ prefetchRows
+        WRITE setPrefetchRows NOTIFY prefetchRowsChanged FINAL )
+
+    using Inherited = QskListView;
+
+  public:
+    QskModelListView( QQuickItem* parent = nullptr );
+    QskModelListView( QAbstractItemModel*, QQuickItem* parent = nullptr );
+
+    ~QskModelListView() override;
+
+    void setModel( QAbstractItemModel* );
+    QAbstractItemModel* model() const;
+
+    // the role for valueAt(), default: Qt::DisplayRole
+    void setDisplayRole( int );
+    int displayRole() const;
+
+    /*
+        Number of rows beyond the visible rows, that are considered
+        being visible: changes are processed for them and
+        QAbstractItemModel::fetchMore is called in advance.
+     */
+    void setPrefetchRows( int );
+    int prefetchRows() const;
+
+    void setColumnWidthHint( int column, qreal width );
+    qreal columnWidthHint( int column ) const;
+
+    int rowCount() const override final;
+    int columnCount() const override final;
+
+    qreal columnWidth( int col ) const override;
+    qreal rowHeight() const override;
+
+    QVariant valueAt( int row, int col ) const override;
+
+  Q_SIGNALS:
+    void modelChanged();
+    void displayRoleChanged();
+    void prefetchRowsChanged();
+
+  protected:
+    void geometryChangeEvent( QskGeometryChangeEvent* ) override;
+
+  private:
+    void resetModel();
+    void updateColumns();
+    void fetchMore();
+
+    bool isRowRangeVisible( int first, int last ) const;
+
+    void onDataChanged( const QModelIndex&, const QModelIndex& );
+    void onRowsInserted( const QModelIndex&, int first, int last );
+    void onRowsRemoved( const QModelIndex&, int first, int last );
+    void onRowsMoved( const QModelIndex&, int first, int last,
+        const QModelIndex&, int row );
+
+    class PrivateData;
+    std::unique_ptr< PrivateData > m_data;
+};
+
+#endif
@@ -17,9 +17,18 @@ namespace
         if ( !qskHasEnvironment( "QSK_PREFER_FBO_PAINTING" ) )
             flags |= QskItem::PreferRasterForTextures;
 
+        if ( qskHasEnvironment( "QSK_ASYNCHRONOUS_PAINTING" ) )
+            flags |= QskItem::PreferAsynchronousPainting;
+
+        if ( qskHasEnvironment( "QSK_GEOMETRY_GRAPHICS" ) )
+            flags |= QskItem::PreferGeometryForGraphics;
+
         if ( qskHasEnvironment( "QSK_FORCE_BACKGROUND" ) )
             flags |= QskItem::DebugForceBackground;
 
+        if ( qskHasEnvironment( "QSK_ASYNCHRONOUS_TESSELLATION" ) )
+            flags |= QskItem::PreferAsynchronousTessellation;
+
         return flags;
     }
 
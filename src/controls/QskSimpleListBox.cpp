@@ -8,37 +8,97 @@
 #include "QskFunctions.h"
 
 #include <qfontmetrics.h>
+#include <qmap.h>
 
-static inline qreal qskMaxWidth(
-    const QFont& font, const QStringList& list )
+static QVector< qreal > qskMeasureEntries( const QFont& font, const QStringList& list )
 {
     const QFontMetricsF fm( font );
 
-    qreal max = 0.0;
-    for ( int i = 0; i < list.size(); i++ )
-    {
-        const qreal w = qskHorizontalAdvance( fm, list[ i ] );
-        if ( w > max )
-            max = w;
-    }
+    QVector< qreal > widths;
+    widths.reserve( list.size() );
 
-    return max;
+    for ( const auto& entry : list )
+        widths += qskHorizontalAdvance( fm, entry );
+
+    return widths;
 }
 
 class QskSimpleListBox::PrivateData
 {
   public:
     PrivateData()
-        : maxTextWidth( 0.0 )
-        , columnWidthHint( 0.0 )
+        : columnWidthHint( 0.0 )
+    {
+    }
+
+    inline bool hasWidths() const
+    {
+        // with a column width hint we don't need to measure
+        return columnWidthHint <= 0.0;
+    }
+
+    inline qreal maxTextWidth() const
+    {
+        if ( !hasWidths() )
+            return columnWidthHint;
+
+        return widthCounts.isEmpty() ? 0.0 : widthCounts.lastKey();
+    }
+
+    void insertWidths( int index, const QVector< qreal >& newWidths )
+    {
+        if ( index < 0 || index > widths.size() )
+            index = widths.size();
+
+        if ( index == widths.size() )
+        {
+            widths += newWidths;
+        }
+        else
+        {
+            widths.insert( index, newWidths.size(), 0.0 );
+
+            for ( int i = 0; i < newWidths.size(); i++ )
+                widths[ index + i ] = newWidths[ i ];
+        }
+
+        for ( const auto w : newWidths )
+            widthCounts[ w ]++;
+    }
+
+    void removeWidths( int from, int count )
+    {
+        for ( int i = from; i < from + count; i++ )
+        {
+            auto it = widthCounts.find( widths[ i ] );
+            if ( --it.value() == 0 )
+                widthCounts.erase( it );
+        }
+
+        widths.remove( from, count );
+    }
+
+    void clearWidths()
     {
+        widths.clear();
+        widthCounts.clear();
     }
 
     // one column at the moment only
-    qreal maxTextWidth;
     qreal columnWidthHint;
 
     QStringList entries;
+
+    /*
+        The text widths of the entries and how often each width occurs,
+        so that the maximum can be updated in O(log n) when
+        inserting/removing entries.
+     */
+    QVector< qreal > widths;
+    QMap< qreal, int > widthCounts;
+
+    // the font, that has been used for measuring
+    QFont font;
 };
 
 QskSimpleListBox::QskSimpleListBox( QQuickItem* parent )
@@ -74,14 +134,16 @@ void QskSimpleListBox::setColumnWidthHint( int column, qreal width )
     if ( column != 0 )
         return;
 
+    width = qMax( width, qreal( 0.0 ) );
+
     if ( width != m_data->columnWidthHint )
     {
-        m_data->columnWidthHint = qMax( width, qreal( 0.0 ) );
+        m_data->columnWidthHint = width;
 
-        if ( m_data->columnWidthHint > 0.0 )
-            m_data->maxTextWidth = m_data->columnWidthHint;
+        if ( m_data->hasWidths() )
+            measureEntries();
         else
-            m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
+            m_data->clearWidths();
 
         updateScrollableSize();
     }
@@ -100,26 +162,29 @@ void QskSimpleListBox::insert( const QStringList& list, int index )
     if ( list.isEmpty() )
         return;
 
-    if ( m_data->columnWidthHint <= 0.0 )
+    if ( index < 0 || index > m_data->entries.size() )
+        index = m_data->entries.size();
+
+    if ( m_data->hasWidths() )
     {
-        const auto w = qskMaxWidth( effectiveFont( Text ), list );
-        if ( w > m_data->maxTextWidth )
-            m_data->maxTextWidth = w;
+        m_data->font = effectiveFont( Text );
+        m_data->insertWidths( index, qskMeasureEntries( m_data->font, list ) );
     }
 
     if ( m_data->entries.isEmpty() )
     {
         m_data->entries = list;
     }
-    else if ( index < 0 || index >= m_data->entries.size() )
+    else if ( index == m_data->entries.size() )
     {
         m_data->entries += list;
     }
     else
     {
-        // is there no better way ???
-        for ( int i = 0; i < list.size(); i++ )
-            m_data->entries.insert( index + i, list[ i ] );
+        auto& entries = m_data->entries;
+        entries = entries.mid( 0, index ) + list + entries.mid( index );
+
+        insertRowHeights( index, list.size() );
     }
 
     propagateEntries();
@@ -131,9 +196,9 @@ void QskSimpleListBox::setEntries( const QStringList& entries )
         return;
 
     m_data->entries.clear();
+    m_data->clearWidths();
 
-    if ( m_data->columnWidthHint <= 0.0 )
-        m_data->maxTextWidth = 0.0;
+    resetRowHeights();
 
     insert( entries, -1 );
 }
@@ -145,17 +210,26 @@ QStringList QskSimpleListBox::entries() const
 
 void QskSimpleListBox::insert( const QString& text, int index )
 {
-    if ( m_data->columnWidthHint <= 0.0 )
+    if ( index < 0 || index > m_data->entries.size() )
+        index = m_data->entries.size();
+
+    if ( m_data->hasWidths() )
     {
-        const auto w = qskHorizontalAdvance( effectiveFont( Cell ), text );
-        if ( w > m_data->maxTextWidth )
-            m_data->maxTextWidth = w;
+        m_data->font = effectiveFont( Text );
+
+        const auto w = qskHorizontalAdvance( m_data->font, text );
+        m_data->insertWidths( index, { w } );
     }
 
-    if ( index < 0 )
+    if ( index == m_data->entries.size() )
+    {
         m_data->entries.append( text );
+    }
     else
+    {
         m_data->entries.insert( index, text );
+        insertRowHeights( index, 1 );
+    }
 
     propagateEntries();
 }
@@ -167,14 +241,11 @@ void QskSimpleListBox::removeAt( int index )
     if ( index < 0 || index >= entries.size() )
         return;
 
-    if ( m_data->columnWidthHint <= 0.0 )
-    {
-        const auto w = qskHorizontalAdvance( effectiveFont( Cell ), entries[ index ] );
-        if ( w >= m_data->maxTextWidth )
-            m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), entries );
-    }
+    if ( m_data->hasWidths() )
+        m_data->removeWidths( index, 1 );
 
     entries.removeAt( index );
+    removeRowHeights( index, 1 );
 
     propagateEntries();
 
@@ -201,11 +272,13 @@ void QskSimpleListBox::removeBulk( int from, int to )
     if ( to < from )
         return;
 
-    for ( int i = to; i >= from; i-- )
-        m_data->entries.removeAt( i );
+    m_data->entries.erase( m_data->entries.begin() + from,
+        m_data->entries.begin() + to + 1 );
+
+    removeRowHeights( from, to - from + 1 );
 
-    if ( m_data->columnWidthHint <= 0.0 )
-        m_data->maxTextWidth = qskMaxWidth( effectiveFont( Text ), m_data->entries );
+    if ( m_data->hasWidths() )
+        m_data->removeWidths( from, to - from + 1 );
 
     propagateEntries();
 
@@ -243,14 +316,37 @@ void QskSimpleListBox::clear()
         return;
 
     m_data->entries.clear();
+    m_data->clearWidths();
 
-    if ( m_data->columnWidthHint <= 0.0 )
-        m_data->maxTextWidth = 0.0;
+    resetRowHeights();
 
     propagateEntries();
     setSelectedRow( -1 );
 }
 
+void QskSimpleListBox::measureEntries()
+{
+    m_data->clearWidths();
+
+    if ( m_data->hasWidths() )
+    {
+        m_data->font = effectiveFont( Text );
+        m_data->insertWidths( 0, qskMeasureEntries( m_data->font, m_data->entries ) );
+    }
+}
+
+void QskSimpleListBox::changeEvent( QEvent* event )
+{
+    if ( event->type() == QEvent::StyleChange )
+    {
+        // the cached widths are invalid, when the font has changed
+        if ( m_data->hasWidths() && m_data->font != effectiveFont( Text ) )
+            measureEntries();
+    }
+
+    Inherited::changeEvent( event );
+}
+
 void QskSimpleListBox::propagateEntries()
 {
 #if 1
@@ -278,7 +374,7 @@ qreal QskSimpleListBox::columnWidth( int col ) const
         return 0.0;
 
     const auto padding = paddingHint( Cell );
-    return m_data->maxTextWidth + padding.left() + padding.right();
+    return m_data->maxTextWidth() + padding.left() + padding.right();
 }
 
 qreal QskSimpleListBox::rowHeight() const
@@ -57,7 +57,11 @@ class QSK_EXPORT QskSimpleListBox : public QskListView
     void entriesChanged();
     void selectedEntryChanged( const QString& );
 
+  protected:
+    void changeEvent( QEvent* ) override;
+
   private:
+    void measureEntries();
     void propagateEntries();
 
     class PrivateData;
@@ -189,6 +189,13 @@ QskSkin::QskSkin( QObject* parent )
     : QObject( parent )
     , m_data( new PrivateData() )
 {
+    /*
+        Hints of a skin are shared by all skinnables and are resolved
+        much more often than being modified: remembering the resolved
+        hints pays off.
+     */
+    m_data->hintTable.setResolutionCacheEnabled( true );
+
     declareSkinlet< QskControl, QskSkinlet >();
 
     declareSkinlet< QskBox, QskBoxSkinlet >();
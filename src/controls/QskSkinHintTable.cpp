@@ -6,10 +6,18 @@
 #include "QskSkinHintTable.h"
 #include "QskAnimationHint.h"
 
+#include <atomic>
 #include <limits>
 
 const QVariant QskSkinHintTable::invalidHint;
 
+class QskSkinHintTable::ResolvedHint
+{
+  public:
+    const QVariant* hint;
+    QskAspect aspect;
+};
+
 inline const QVariant* qskResolvedHint( QskAspect aspect,
     const QHash< QskAspect, QVariant >& hints, QskAspect* resolvedAspect )
 {
@@ -69,13 +77,22 @@ inline const QVariant* qskResolvedHint( QskAspect aspect,
     }
 }
 
+static inline quint64 qskNextVersion()
+{
+    static std::atomic< quint64 > counter( 0 );
+    return ++counter;
+}
+
 QskSkinHintTable::QskSkinHintTable()
+    : m_version( qskNextVersion() )
 {
 }
 
 QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
-    : m_animatorCount( other.m_animatorCount )
+    : m_version( qskNextVersion() )
+    , m_animatorCount( other.m_animatorCount )
     , m_states( other.m_states )
+    , m_cacheResolutions( other.m_cacheResolutions )
 {
     if ( other.m_hints )
     {
@@ -97,6 +114,7 @@ QskSkinHintTable::QskSkinHintTable( const QskSkinHintTable& other )
 
 QskSkinHintTable::~QskSkinHintTable()
 {
+    delete m_resolvedHints;
     delete m_hints;
 }
 
@@ -104,6 +122,9 @@ QskSkinHintTable& QskSkinHintTable::operator=( const QskSkinHintTable& other )
 {
     m_animatorCount = ( other.m_animatorCount );
     m_states = other.m_states;
+    m_cacheResolutions = other.m_cacheResolutions;
+
+    invalidateResolutionCache();
 
     delete m_hints;
     m_hints = nullptr;
@@ -130,6 +151,13 @@ bool QskSkinHintTable::setHint( QskAspect aspect, const QVariant& skinHint )
     if ( m_hints == nullptr )
         m_hints = new QHash< QskAspect, QVariant >();
 
+    /*
+        Even when only modifying the value of an existing hint
+        the cached pointers might become invalid as
+        QHash::find detaches a shared hash table.
+     */
+    invalidateResolutionCache();
+
     auto it = m_hints->find( aspect );
     if ( it == m_hints->end() )
     {
@@ -162,6 +190,8 @@ bool QskSkinHintTable::removeHint( QskAspect aspect )
     if ( m_hints == nullptr )
         return false;
 
+    invalidateResolutionCache();
+
     const bool erased = m_hints->remove( aspect );
 
     if ( erased )
@@ -185,6 +215,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 {
     if ( m_hints )
     {
+        invalidateResolutionCache();
+
         auto it = m_hints->find( aspect );
         if ( it != m_hints->end() )
         {
@@ -211,6 +243,8 @@ QVariant QskSkinHintTable::takeHint( QskAspect aspect )
 
 void QskSkinHintTable::clear()
 {
+    invalidateResolutionCache();
+
     delete m_hints;
     m_hints = nullptr;
 
@@ -221,22 +255,64 @@ void QskSkinHintTable::clear()
 const QVariant* QskSkinHintTable::resolvedHint(
     QskAspect aspect, QskAspect* resolvedAspect ) const
 {
-    if ( m_hints != nullptr )
-        return qskResolvedHint( aspect & m_states, *m_hints, resolvedAspect );
+    if ( m_hints == nullptr )
+        return nullptr;
+
+    aspect &= m_states;
 
-    return nullptr;
+    if ( !m_cacheResolutions )
+        return qskResolvedHint( aspect, *m_hints, resolvedAspect );
+
+    if ( m_resolvedHints == nullptr )
+        m_resolvedHints = new QHash< QskAspect, ResolvedHint >();
+
+    auto it = m_resolvedHints->constFind( aspect );
+    if ( it == m_resolvedHints->constEnd() )
+    {
+        /*
+            Unresolvable aspects are stored as well, so that
+            the fallback to the skin defaults is also a single lookup
+         */
+        ResolvedHint resolved;
+        resolved.hint = qskResolvedHint( aspect, *m_hints, &resolved.aspect );
+
+        it = m_resolvedHints->insert( aspect, resolved );
+    }
+
+    if ( resolvedAspect && it->hint )
+        *resolvedAspect = it->aspect;
+
+    return it->hint;
 }
 
 QskAspect QskSkinHintTable::resolvedAspect( QskAspect aspect ) const
 {
     QskAspect a;
-
-    if ( m_hints != nullptr )
-        qskResolvedHint( aspect & m_states, *m_hints, &a );
+    ( void ) resolvedHint( aspect, &a );
 
     return a;
 }
 
+void QskSkinHintTable::setResolutionCacheEnabled( bool on )
+{
+    if ( on != m_cacheResolutions )
+    {
+        m_cacheResolutions = on;
+
+        if ( !on )
+            invalidateResolutionCache();
+    }
+}
+
+void QskSkinHintTable::invalidateResolutionCache()
+{
+    // called for all modifications
+    m_version = qskNextVersion();
+
+    delete m_resolvedHints;
+    m_resolvedHints = nullptr;
+}
+
 QskAspect QskSkinHintTable::resolvedAnimator(
     QskAspect aspect, QskAnimationHint& hint ) const
 {
@@ -55,14 +55,38 @@ class QSK_EXPORT QskSkinHintTable
 
     bool isResolutionMatching( QskAspect, QskAspect ) const;
 
+    void setResolutionCacheEnabled( bool );
+    bool isResolutionCacheEnabled() const;
+
+    /*
+        A value, that changes with every modification of the table.
+        The values are unique for all tables, so that caches
+        can detect modifications and replacements of tables.
+     */
+    quint64 version() const;
+
   private:
+    void invalidateResolutionCache();
 
     static const QVariant invalidHint;
 
     QHash< QskAspect, QVariant >* m_hints = nullptr;
 
+    /*
+        Resolving an aspect walks through a chain of fallbacks
+        with a hash lookup for each step. As the hints of a skin are
+        usually not modified after the initial setup, we can remember
+        the result of a resolution and replace the chain by a single lookup.
+     */
+    class ResolvedHint;
+    mutable QHash< QskAspect, ResolvedHint >* m_resolvedHints = nullptr;
+
+    quint64 m_version;
+
     unsigned short m_animatorCount = 0;
     QskAspect::States m_states;
+
+    bool m_cacheResolutions = false;
 };
 
 inline bool QskSkinHintTable::hasHints() const
@@ -75,6 +99,16 @@ inline QskAspect::States QskSkinHintTable::states() const
     return m_states;
 }
 
+inline bool QskSkinHintTable::isResolutionCacheEnabled() const
+{
+    return m_cacheResolutions;
+}
+
+inline quint64 QskSkinHintTable::version() const
+{
+    return m_version;
+}
+
 inline bool QskSkinHintTable::hasAnimators() const
 {
     return m_animatorCount > 0;
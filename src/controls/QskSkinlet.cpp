@@ -27,6 +27,7 @@
 #include "QskTextOptions.h"
 #include "QskSkinStateChanger.h"
 #include "QskTextureRenderer.h"
+#include "QskVectorGraphicNode.h"
 #include "QskSetup.h"
 
 #include <qquickwindow.h>
@@ -119,17 +120,42 @@ static inline QSGNode* qskUpdateGraphicNode(
     if ( item == nullptr )
         return nullptr;
 
-    auto graphicNode = static_cast< QskGraphicNode* >( node );
-    if ( graphicNode == nullptr )
-        graphicNode = new QskGraphicNode();
-
     const auto flag = QskItem::PreferRasterForTextures;
+    const auto asyncFlag = QskItem::PreferAsynchronousPainting;
+    const auto geometryFlag = QskItem::PreferGeometryForGraphics;
 
     bool useRaster = QskSetup::testUpdateFlag( flag );
+    bool isAsynchronous = QskSetup::testUpdateFlag( asyncFlag );
+    bool useGeometry = QskSetup::testUpdateFlag( geometryFlag );
+
     if ( auto qItem = qobject_cast< const QskItem* >( item ) )
+    {
         useRaster = qItem->testUpdateFlag( flag );
+        isAsynchronous = qItem->testUpdateFlag( asyncFlag );
+        useGeometry = qItem->testUpdateFlag( geometryFlag );
+    }
+
+    /*
+        QskGraphicNode is a QSGNode, QskVectorGraphicNode is a QSGGeometryNode,
+        what allows to identify the type of a previous node.
+     */
+    const bool isVectorNode = node && ( node->type() == QSGNode::GeometryNodeType );
+
+    if ( useGeometry && QskVectorGraphicNode::isSupported( graphic ) )
+    {
+        auto vectorNode = isVectorNode
+            ? static_cast< QskVectorGraphicNode* >( node ) : new QskVectorGraphicNode();
+
+        vectorNode->setGraphic( graphic, colorFilter, rect, mirrored );
+        return vectorNode;
+    }
+
+    auto graphicNode = isVectorNode ? nullptr : static_cast< QskGraphicNode* >( node );
+    if ( graphicNode == nullptr )
+        graphicNode = new QskGraphicNode();
 
     graphicNode->setRenderHint( useRaster ? QskPaintedNode::Raster : QskPaintedNode::OpenGL );
+    graphicNode->setAsynchronous( isAsynchronous );
 
     graphicNode->setMirrored( mirrored );
 
@@ -49,12 +49,6 @@ static inline bool qskSetFlag( QskSkinnable* skinnable,
     return skinnable->setSkinHint( aspect, QVariant( flag ) );
 }
 
-static inline int qskFlag( const QskSkinnable* skinnable,
-    const QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint( aspect, status ).toInt();
-}
-
 static inline bool qskSetMetric( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& metric )
 {
@@ -81,14 +75,6 @@ static inline bool qskMoveMetric( QskSkinnable* skinnable,
     return qskMoveMetric( skinnable, aspect, QVariant::fromValue( metric ) );
 }
 
-template< typename T >
-static inline T qskMetric( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Metric, status ).value< T >();
-}
-
 static inline bool qskSetColor( QskSkinnable* skinnable,
     const QskAspect aspect, const QVariant& color )
 {
@@ -115,14 +101,6 @@ static inline bool qskMoveColor( QskSkinnable* skinnable,
     return qskMoveColor( skinnable, aspect, QVariant::fromValue( color ) );
 }
 
-template< typename T >
-static inline T qskColor( const QskSkinnable* skinnable,
-    QskAspect aspect, QskSkinHintStatus* status = nullptr )
-{
-    return skinnable->effectiveSkinHint(
-        aspect | QskAspect::Color, status ).value< T >();
-}
-
 static inline constexpr QskAspect qskAnimatorAspect( const QskAspect aspect )
 {
     /*
@@ -232,6 +210,28 @@ static inline QskAspect qskSubstitutedAspect(
     return aspect;
 }
 
+namespace
+{
+    class HintCache
+    {
+      public:
+        class Entry
+        {
+          public:
+            QVariant hint;
+            QskSkinHintStatus status;
+        };
+
+        const QskSkin* skin = nullptr;
+        quint64 skinVersion = 0;
+
+        QHash< QskAspect, Entry > entries;
+
+        quint32 hits = 0;
+        quint32 misses = 0;
+    };
+}
+
 class QskSkinnable::PrivateData
 {
   public:
@@ -244,6 +244,7 @@ class QskSkinnable::PrivateData
         }
 
         delete subcontrolProxies;
+        delete hintCache;
     }
 
     QskSkinHintTable hintTable;
@@ -256,6 +257,8 @@ class QskSkinnable::PrivateData
 
     const QskSkinlet* skinlet = nullptr;
 
+    HintCache* hintCache = nullptr;
+
     QskAspect::States skinStates;
     bool hasLocalSkinlet = false;
 };
@@ -287,6 +290,8 @@ void QskSkinnable::setSkinlet( const QskSkinlet* skinlet )
     m_data->skinlet = skinlet;
     m_data->hasLocalSkinlet = ( skinlet != nullptr );
 
+    invalidateHintCache();
+
     if ( auto item = owningItem() )
     {
         if ( auto control = qskControlCast( item ) )
@@ -364,6 +369,9 @@ QskAspect::Subcontrol QskSkinnable::subcontrolProxy( QskAspect::Subcontrol subCo
 
 QskSkinHintTable& QskSkinnable::hintTable()
 {
+    // the table might be modified
+    invalidateHintCache();
+
     return m_data->hintTable;
 }
 
@@ -419,7 +427,7 @@ bool QskSkinnable::moveColor( const QskAspect aspect, QRgb rgb )
 
 QColor QskSkinnable::color( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect, status );
+    return effectiveHint< QColor >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setMetric( const QskAspect aspect, qreal metric )
@@ -434,14 +442,14 @@ bool QskSkinnable::moveMetric( QskAspect aspect, qreal metric )
 
 qreal QskSkinnable::metric( const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect, status );
+    return effectiveHint< qreal >( aspect | QskAspect::Metric, status );
 }
 
 qreal QskSkinnable::metric( QskAspect aspect, qreal defaultValue ) const
 {
     QskSkinHintStatus status;
 
-    const auto value = qskMetric< qreal >( this, aspect, &status );
+    const auto value = effectiveHint< qreal >( aspect | QskAspect::Metric, &status );
     return status.isValid() ? value : defaultValue;
 }
 
@@ -468,7 +476,8 @@ bool QskSkinnable::resetPositionHint( QskAspect aspect )
 
 qreal QskSkinnable::positionHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Position, status );
+    return effectiveHint< qreal >(
+        aspect | QskAspect::Metric | QskAspect::Position, status );
 }
 
 bool QskSkinnable::setStrutSizeHint(
@@ -490,7 +499,8 @@ bool QskSkinnable::resetStrutSizeHint( const QskAspect aspect )
 QSizeF QskSkinnable::strutSizeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QSizeF >( this, aspect | QskAspect::StrutSize, status );
+    return effectiveHint< QSizeF >(
+        aspect | QskAspect::Metric | QskAspect::StrutSize, status );
 }
 
 bool QskSkinnable::setMarginHint( const QskAspect aspect, qreal margins )
@@ -511,7 +521,8 @@ bool QskSkinnable::resetMarginHint( const QskAspect aspect )
 QMarginsF QskSkinnable::marginHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Margin, status );
+    return effectiveHint< QskMargins >(
+        aspect | QskAspect::Metric | QskAspect::Margin, status );
 }
 
 bool QskSkinnable::setPaddingHint( const QskAspect aspect, qreal padding )
@@ -532,7 +543,8 @@ bool QskSkinnable::resetPaddingHint( const QskAspect aspect )
 QMarginsF QskSkinnable::paddingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskMargins >( this, aspect | QskAspect::Padding, status );
+    return effectiveHint< QskMargins >(
+        aspect | QskAspect::Metric | QskAspect::Padding, status );
 }
 
 bool QskSkinnable::setGradientHint(
@@ -544,7 +556,7 @@ bool QskSkinnable::setGradientHint(
 QskGradient QskSkinnable::gradientHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskGradient >( this, aspect, status );
+    return effectiveHint< QskGradient >( aspect | QskAspect::Color, status );
 }
 
 bool QskSkinnable::setBoxShapeHint(
@@ -561,8 +573,8 @@ bool QskSkinnable::resetBoxShapeHint( const QskAspect aspect )
 QskBoxShapeMetrics QskSkinnable::boxShapeHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxShapeMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return effectiveHint< QskBoxShapeMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shape, status );
 }
 
 bool QskSkinnable::setBoxBorderMetricsHint(
@@ -579,8 +591,8 @@ bool QskSkinnable::resetBoxBorderMetricsHint( const QskAspect aspect )
 QskBoxBorderMetrics QskSkinnable::boxBorderMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskBoxBorderMetrics >(
-        this, aspect | QskAspect::Border, status );
+    return effectiveHint< QskBoxBorderMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Border, status );
 }
 
 bool QskSkinnable::setBoxBorderColorsHint(
@@ -597,8 +609,8 @@ bool QskSkinnable::resetBoxBorderColorsHint( const QskAspect aspect )
 QskBoxBorderColors QskSkinnable::boxBorderColorsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QskBoxBorderColors >(
-        this, aspect | QskAspect::Border, status );
+    return effectiveHint< QskBoxBorderColors >(
+        aspect | QskAspect::Color | QskAspect::Border, status );
 }
 
 bool QskSkinnable::setShadowMetricsHint(
@@ -615,8 +627,8 @@ bool QskSkinnable::resetShadowMetricsHint( QskAspect aspect )
 QskShadowMetrics QskSkinnable::shadowMetricsHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskShadowMetrics >(
-        this, aspect | QskAspect::Shadow, status );
+    return effectiveHint< QskShadowMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shadow, status );
 }
 
 bool QskSkinnable::setShadowColorHint( QskAspect aspect, const QColor& color )
@@ -631,7 +643,8 @@ bool QskSkinnable::resetShadowColorHint( QskAspect aspect )
 
 QColor QskSkinnable::shadowColorHint( QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskColor< QColor >( this, aspect | QskAspect::Shadow, status );
+    return effectiveHint< QColor >(
+        aspect | QskAspect::Color | QskAspect::Shadow, status );
 }
 
 QskBoxHints QskSkinnable::boxHints( QskAspect aspect ) const
@@ -670,8 +683,8 @@ bool QskSkinnable::resetArcMetricsHint( const QskAspect aspect )
 QskArcMetrics QskSkinnable::arcMetricsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskArcMetrics >(
-        this, aspect | QskAspect::Shape, status );
+    return effectiveHint< QskArcMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Shape, status );
 }
 
 bool QskSkinnable::setStippleMetricsHint(
@@ -688,8 +701,8 @@ bool QskSkinnable::resetStippleMetricsHint( QskAspect aspect )
 QskStippleMetrics QskSkinnable::stippleMetricsHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< QskStippleMetrics >(
-        this, aspect | QskAspect::Style, status );
+    return effectiveHint< QskStippleMetrics >(
+        aspect | QskAspect::Metric | QskAspect::Style, status );
 }
 
 bool QskSkinnable::setSpacingHint( const QskAspect aspect, qreal spacing )
@@ -705,7 +718,8 @@ bool QskSkinnable::resetSpacingHint( const QskAspect aspect )
 qreal QskSkinnable::spacingHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskMetric< qreal >( this, aspect | QskAspect::Spacing, status );
+    return effectiveHint< qreal >(
+        aspect | QskAspect::Metric | QskAspect::Spacing, status );
 }
 
 bool QskSkinnable::setTextOptionsHint(
@@ -723,8 +737,7 @@ bool QskSkinnable::resetTextOptionsHint( const QskAspect aspect )
 QskTextOptions QskSkinnable::textOptionsHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveSkinHint(
-        aspect | QskAspect::Option, status ).value< QskTextOptions >();
+    return effectiveHint< QskTextOptions >( aspect | QskAspect::Option, status );
 }
 
 bool QskSkinnable::setFontRoleHint(
@@ -742,8 +755,7 @@ bool QskSkinnable::resetFontRoleHint( const QskAspect aspect )
 QskFontRole QskSkinnable::fontRoleHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveSkinHint(
-        aspect | QskAspect::FontRole, status ).value< QskFontRole >();
+    return effectiveHint< QskFontRole >( aspect | QskAspect::FontRole, status );
 }
 
 QFont QskSkinnable::effectiveFont( QskAspect aspect ) const
@@ -797,7 +809,7 @@ bool QskSkinnable::resetGraphicRoleHint( const QskAspect aspect )
 int QskSkinnable::graphicRoleHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return qskFlag( this, aspect | QskAspect::GraphicRole, status );
+    return effectiveHint< int >( aspect | QskAspect::GraphicRole, status );
 }
 
 bool QskSkinnable::setSymbolHint(
@@ -815,8 +827,7 @@ bool QskSkinnable::resetSymbolHint( const QskAspect aspect )
 QskGraphic QskSkinnable::symbolHint(
     const QskAspect aspect, QskSkinHintStatus* status ) const
 {
-    return effectiveSkinHint(
-        aspect | QskAspect::Symbol, status ).value< QskGraphic >();
+    return effectiveHint< QskGraphic >( aspect | QskAspect::Symbol, status );
 }
 
 
@@ -879,7 +890,14 @@ bool QskSkinnable::setAnimationHint(
     QskAspect aspect, QskAnimationHint hint )
 {
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
-    return m_data->hintTable.setAnimation( aspect, hint );
+
+    if ( m_data->hintTable.setAnimation( aspect, hint ) )
+    {
+        invalidateHintCache();
+        return true;
+    }
+
+    return false;
 }
 
 QskAnimationHint QskSkinnable::animationHint(
@@ -952,6 +970,7 @@ bool QskSkinnable::setSkinHint( QskAspect aspect, const QVariant& hint )
 
     if ( m_data->hintTable.setHint( aspect, hint ) )
     {
+        invalidateHintCache();
         qskTriggerUpdates( aspect, owningItem() );
         return true;
     }
@@ -965,6 +984,7 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 
     if ( m_data->hintTable.removeHint( aspect ) )
     {
+        invalidateHintCache();
         qskTriggerUpdates( aspect, owningItem() );
         return true;
     }
@@ -975,13 +995,24 @@ bool QskSkinnable::resetSkinHint( QskAspect aspect )
 QVariant QskSkinnable::effectiveSkinHint(
     QskAspect aspect, QskSkinHintStatus* status ) const
 {
+    QVariant animatedValue;
+    return effectiveHint( aspect, status, animatedValue );
+}
+
+const QVariant& QskSkinnable::effectiveHint( QskAspect aspect,
+    QskSkinHintStatus* status, QVariant& animatedValue ) const
+{
+    /*
+        Hints from the tables are returned by reference, only
+        values from running animators need to be stored in animatedValue.
+     */
     aspect.setSubcontrol( effectiveSubcontrol( aspect.subControl() ) );
 
     if ( !( aspect.isAnimator() || aspect.hasStates() ) )
     {
-        const auto v = animatedHint( aspect, status );
-        if ( v.isValid() )
-            return v;
+        animatedValue = animatedHint( aspect, status );
+        if ( animatedValue.isValid() )
+            return animatedValue;
     }
 
     if ( aspect.section() == QskAspect::Body )
@@ -999,14 +1030,66 @@ QVariant QskSkinnable::effectiveSkinHint(
             The skin has changed and the hints are interpolated
             between the old and the new one over time
          */
-        const auto v = interpolatedHint( aspect, status );
-        if ( v.isValid() )
-            return v;
+        animatedValue = interpolatedHint( aspect, status );
+        if ( animatedValue.isValid() )
+            return animatedValue;
+    }
+
+    if ( auto cache = m_data->hintCache )
+    {
+        /*
+            Values from animators have been checked before, so
+            starting/stopping them does not affect the cache. As the states
+            are part of the key we don't need to invalidate it on state changes.
+         */
+
+        /*
+            Hints of the current skin might be modified at runtime without
+            getting a StyleChange event, so we also have to check
+            the version of its table.
+         */
+        const auto skin = effectiveSkin();
+        const auto skinVersion = skin->hintTable().version();
+
+        if ( cache->skin != skin || cache->skinVersion != skinVersion )
+        {
+            cache->entries.clear();
+
+            cache->skin = skin;
+            cache->skinVersion = skinVersion;
+        }
+
+        auto it = cache->entries.constFind( aspect );
+        if ( it != cache->entries.constEnd() )
+        {
+            cache->hits++;
+        }
+        else
+        {
+            cache->misses++;
+
+            HintCache::Entry entry;
+            entry.hint = storedHint( aspect, &entry.status );
+
+            it = cache->entries.insert( aspect, entry );
+        }
+
+        if ( status )
+            *status = it->status;
+
+        return it->hint;
     }
 
     return storedHint( aspect, status );
 }
 
+template< typename T >
+T QskSkinnable::effectiveHint( QskAspect aspect, QskSkinHintStatus* status ) const
+{
+    QVariant animatedValue;
+    return effectiveHint( aspect, status, animatedValue ).value< T >();
+}
+
 QskSkinHintStatus QskSkinnable::hintStatus( QskAspect aspect ) const
 {
     QskSkinHintStatus status;
@@ -1015,6 +1098,43 @@ QskSkinHintStatus QskSkinnable::hintStatus( QskAspect aspect ) const
     return status;
 }
 
+void QskSkinnable::setHintCacheEnabled( bool on )
+{
+    if ( on == ( m_data->hintCache != nullptr ) )
+        return;
+
+    if ( on )
+    {
+        m_data->hintCache = new HintCache();
+    }
+    else
+    {
+        delete m_data->hintCache;
+        m_data->hintCache = nullptr;
+    }
+}
+
+bool QskSkinnable::isHintCacheEnabled() const
+{
+    return m_data->hintCache != nullptr;
+}
+
+void QskSkinnable::invalidateHintCache()
+{
+    if ( auto cache = m_data->hintCache )
+        cache->entries.clear();
+}
+
+quint32 QskSkinnable::hintCacheHits() const
+{
+    return m_data->hintCache ? m_data->hintCache->hits : 0;
+}
+
+quint32 QskSkinnable::hintCacheMisses() const
+{
+    return m_data->hintCache ? m_data->hintCache->misses : 0;
+}
+
 bool QskSkinnable::moveSkinHint( QskAspect aspect,
     const QVariant& oldValue, const QVariant& newValue )
 {
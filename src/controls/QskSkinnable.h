@@ -114,6 +114,13 @@ class QSK_EXPORT QskSkinnable
 
     QskSkinHintStatus hintStatus( QskAspect ) const;
 
+    void setHintCacheEnabled( bool );
+    bool isHintCacheEnabled() const;
+    void invalidateHintCache();
+
+    quint32 hintCacheHits() const;
+    quint32 hintCacheMisses() const;
+
     QRectF subControlRect( const QRectF&, QskAspect::Subcontrol ) const;
     QRectF subControlContentsRect( const QRectF&, QskAspect::Subcontrol ) const;
 
@@ -283,6 +290,9 @@ class QSK_EXPORT QskSkinnable
     void startHintTransition( QskAspect, int index,
         QskAnimationHint, const QVariant& from, const QVariant& to );
 
+    template< typename T > T effectiveHint( QskAspect, QskSkinHintStatus* ) const;
+    const QVariant& effectiveHint( QskAspect, QskSkinHintStatus*, QVariant& ) const;
+
     QVariant animatedHint( QskAspect, QskSkinHintStatus* ) const;
     QVariant interpolatedHint( QskAspect, QskSkinHintStatus* ) const;
     const QVariant& storedHint( QskAspect, QskSkinHintStatus* = nullptr ) const;
@@ -6,6 +6,7 @@
 #include "QskGraphic.h"
 #include "QskColorFilter.h"
 #include "QskGraphicPaintEngine.h"
+#include "QskGraphicTessellation.h"
 #include "QskPainterCommand.h"
 #include "QskInternalMacros.h"
 
@@ -343,6 +344,7 @@ class QskGraphic::PrivateData : public QSharedData
         , viewBox( other.viewBox )
         , commands( other.commands )
         , pathInfos( other.pathInfos )
+        , tessellation( other.tessellation )
         , boundingRect( other.boundingRect )
         , pointRect( other.pointRect )
         , modificationId( other.modificationId )
@@ -362,6 +364,7 @@ class QskGraphic::PrivateData : public QSharedData
     {
         commands.clear();
         pathInfos.clear();
+        tessellation = QskGraphicTessellation();
 
         commandTypes = 0;
         boundingRect = pointRect = { 0.0, 0.0, -1.0, -1.0 };
@@ -372,6 +375,7 @@ class QskGraphic::PrivateData : public QSharedData
     inline void addCommand( const QskPainterCommand& command )
     {
         commands += command;
+        tessellation = QskGraphicTessellation();
 
         static QAtomicInteger< quint64 > nextId( 1 );
         modificationId = nextId.fetchAndAddRelaxed( 1 );
@@ -380,6 +384,7 @@ class QskGraphic::PrivateData : public QSharedData
     QRectF viewBox = { 0.0, 0.0, -1.0, -1.0 };
     QVector< QskPainterCommand > commands;
     QVector< QskGraphicPrivate::PathInfo > pathInfos;
+    QskGraphicTessellation tessellation;
 
     QRectF boundingRect = { 0.0, 0.0, -1.0, -1.0 };
     QRectF pointRect = { 0.0, 0.0, -1.0, -1.0 };
@@ -1047,6 +1052,16 @@ void QskGraphic::setCommands( const QVector< QskPainterCommand >& commands )
     painter.end();
 }
 
+void QskGraphic::setTessellation( const QskGraphicTessellation& tessellation )
+{
+    m_data->tessellation = tessellation;
+}
+
+QskGraphicTessellation QskGraphic::tessellation() const
+{
+    return m_data->tessellation;
+}
+
 quint64 QskGraphic::modificationId() const
 {
     return m_data->modificationId;
@@ -16,6 +16,7 @@
 class QskPainterCommand;
 class QskColorFilter;
 class QskGraphicPaintEngine;
+class QskGraphicTessellation;
 class QImage;
 class QPixmap;
 class QPainterPath;
@@ -109,6 +110,14 @@ class QSK_EXPORT QskGraphic : public QPaintDevice
     const QVector< QskPainterCommand >& commands() const;
     void setCommands( const QVector< QskPainterCommand >& );
 
+    /*
+        An optional tessellation of the commands, that allows rendering
+        the graphic without painting it into a texture. It is reset,
+        whenever the commands are modified.
+     */
+    void setTessellation( const QskGraphicTessellation& );
+    QskGraphicTessellation tessellation() const;
+
     QSizeF defaultSize() const;
 
     void setViewBox( const QRectF& );
@@ -5,6 +5,7 @@
 
 #include "QskGraphicIO.h"
 #include "QskGraphic.h"
+#include "QskGraphicTessellation.h"
 #include "QskPainterCommand.h"
 
 #include <qbuffer.h>
@@ -15,6 +16,7 @@
 #include <cstring>
 
 static const char qskMagicNumber[] = "QSKG";
+static const char qskMappableMagicNumber[] = "QSK2";
 
 /*
     To avoid crashes ( fonts ), when svg2qvg was running with a different Qt
@@ -60,6 +62,7 @@ static inline void qskWriteImageData(
     const QskPainterCommand::ImageData& data, QDataStream& s )
 {
     s << data.rect << data.image << data.subRect;
+    s << static_cast< quint8 >( data.flags );
 }
 
 static inline void qskReadImageData(
@@ -202,6 +205,726 @@ static inline void qskReadStateData(
     commands += QskPainterCommand( data );
 }
 
+/*
+    The mappable format stores the commands in flat arrays of records
+    in native byte order:
+
+        Header
+        CommandRecord[]
+        PathRecord[]
+        ElementRecord[]
+        StateRecord[]
+        blobs
+        AreaRecord[]
+        vertices
+
+    The areas of the optional QskGraphicTessellation are stored as
+    triangles with x/y coordinates as float.
+
+    All sections are aligned to 8 bytes, so that the records can be
+    accessed in place, when the file has been mapped into memory.
+
+    Pixmaps, images and states, that can't be expressed by a StateRecord
+    ( gradients, fonts, clipping ... ) are stored as blobs using the
+    stream format.
+ */
+
+namespace
+{
+    enum : quint32
+    {
+        MappableVersion = 2,
+        ByteOrderMark = 0x01020304
+    };
+
+    class Section
+    {
+      public:
+        quint32 offset;
+        quint32 count;
+    };
+
+    class Header
+    {
+      public:
+        char magicNumber[ 4 ];
+        quint32 byteOrderMark;
+        quint32 version;
+        quint32 reserved;
+
+        double viewBox[ 4 ];
+
+        Section commands;
+        Section paths;
+        Section elements;
+        Section states;
+        Section blobs; // count: number of bytes
+        Section areas;
+        Section vertices; // count: number of x/y pairs
+    };
+
+    class CommandRecord
+    {
+      public:
+        quint32 type;
+
+        // index of the path/state record or offset of the blob
+        quint32 index;
+        quint32 size;
+
+        quint32 reserved;
+    };
+
+    class PathRecord
+    {
+      public:
+        quint32 firstElement;
+        quint32 elementCount;
+        quint32 fillRule;
+        quint32 reserved;
+    };
+
+    class ElementRecord
+    {
+      public:
+        double x;
+        double y;
+        qint32 type;
+        qint32 reserved;
+    };
+
+    class AreaRecord
+    {
+      public:
+        quint32 color;
+        float opacity;
+        quint32 firstVertex;
+        quint32 vertexCount;
+    };
+
+    class StateRecord
+    {
+      public:
+        quint32 flags;
+
+        // a blobSize > 0 indicates, that the state is stored as blob
+        quint32 blobOffset;
+        quint32 blobSize;
+
+        quint32 renderHints;
+
+        quint64 penColor;
+        quint64 brushColor;
+
+        double penWidth;
+        double miterLimit;
+        double opacity;
+        double transform[ 9 ];
+
+        quint16 penStyle;
+        quint16 capStyle;
+        quint16 joinStyle;
+        quint16 compositionMode;
+
+        quint8 isCosmetic;
+        quint8 penBrushStyle;
+        quint8 brushStyle;
+        quint8 isClipEnabled;
+        quint8 reserved[ 4 ];
+    };
+
+    static_assert( sizeof( Header ) == 104, "unexpected padding" );
+    static_assert( sizeof( CommandRecord ) == 16, "unexpected padding" );
+    static_assert( sizeof( PathRecord ) == 16, "unexpected padding" );
+    static_assert( sizeof( ElementRecord ) == 24, "unexpected padding" );
+    static_assert( sizeof( StateRecord ) == 144, "unexpected padding" );
+    static_assert( sizeof( AreaRecord ) == 16, "unexpected padding" );
+}
+
+static inline int qskAligned( int size )
+{
+    return ( size + 7 ) & ~7;
+}
+
+static inline bool qskIsMappableData( const char* data, qint64 size )
+{
+    return ( size >= 4 ) && ( memcmp( data, qskMappableMagicNumber, 4 ) == 0 );
+}
+
+static inline bool qskIsSolidBrush( const QBrush& brush )
+{
+    const auto style = brush.style();
+
+    return ( style == Qt::NoBrush )
+        || ( style == Qt::SolidPattern && brush.transform().isIdentity() );
+}
+
+static bool qskIsFlatState( const QskPainterCommand::StateData& data )
+{
+    const QPaintEngine::DirtyFlags flatFlags = QPaintEngine::DirtyPen
+        | QPaintEngine::DirtyBrush | QPaintEngine::DirtyTransform
+        | QPaintEngine::DirtyClipEnabled | QPaintEngine::DirtyHints
+        | QPaintEngine::DirtyCompositionMode | QPaintEngine::DirtyOpacity;
+
+    if ( data.flags & ~flatFlags )
+        return false;
+
+    if ( data.flags & QPaintEngine::DirtyPen )
+    {
+        const auto& pen = data.pen;
+
+        if ( pen.style() == Qt::CustomDashLine || pen.dashOffset() != 0.0 )
+            return false;
+
+        if ( !qskIsSolidBrush( pen.brush() ) )
+            return false;
+    }
+
+    if ( data.flags & QPaintEngine::DirtyBrush )
+    {
+        if ( !qskIsSolidBrush( data.brush ) )
+            return false;
+    }
+
+    return true;
+}
+
+static StateRecord qskStateRecord( const QskPainterCommand::StateData& data )
+{
+    StateRecord r;
+    memset( &r, 0, sizeof( r ) );
+
+    r.flags = static_cast< quint32 >( data.flags );
+
+    if ( data.flags & QPaintEngine::DirtyPen )
+    {
+        const auto& pen = data.pen;
+
+        r.penColor = pen.color().rgba64();
+        r.penWidth = pen.widthF();
+        r.miterLimit = pen.miterLimit();
+        r.penStyle = static_cast< quint16 >( pen.style() );
+        r.capStyle = static_cast< quint16 >( pen.capStyle() );
+        r.joinStyle = static_cast< quint16 >( pen.joinStyle() );
+        r.isCosmetic = pen.isCosmetic();
+        r.penBrushStyle = static_cast< quint8 >( pen.brush().style() );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyBrush )
+    {
+        r.brushColor = data.brush.color().rgba64();
+        r.brushStyle = static_cast< quint8 >( data.brush.style() );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyTransform )
+    {
+        const auto& t = data.transform;
+
+        const double values[] = { t.m11(), t.m12(), t.m13(),
+            t.m21(), t.m22(), t.m23(), t.m31(), t.m32(), t.m33() };
+
+        memcpy( r.transform, values, sizeof( values ) );
+    }
+
+    r.isClipEnabled = data.isClipEnabled;
+    r.renderHints = static_cast< quint32 >( data.renderHints );
+    r.compositionMode = static_cast< quint16 >( data.compositionMode );
+    r.opacity = data.opacity;
+
+    return r;
+}
+
+static QskPainterCommand::StateData qskStateData( const StateRecord& r )
+{
+    QskPainterCommand::StateData data;
+    data.flags = static_cast< QPaintEngine::DirtyFlags >( r.flags );
+
+    if ( data.flags & QPaintEngine::DirtyPen )
+    {
+        const QBrush brush( QColor( QRgba64::fromRgba64( r.penColor ) ),
+            static_cast< Qt::BrushStyle >( r.penBrushStyle ) );
+
+        QPen pen( brush, r.penWidth,
+            static_cast< Qt::PenStyle >( r.penStyle ),
+            static_cast< Qt::PenCapStyle >( r.capStyle ),
+            static_cast< Qt::PenJoinStyle >( r.joinStyle ) );
+
+        pen.setMiterLimit( r.miterLimit );
+        pen.setCosmetic( r.isCosmetic );
+
+        data.pen = pen;
+    }
+
+    if ( data.flags & QPaintEngine::DirtyBrush )
+    {
+        data.brush = QBrush( QColor( QRgba64::fromRgba64( r.brushColor ) ),
+            static_cast< Qt::BrushStyle >( r.brushStyle ) );
+    }
+
+    if ( data.flags & QPaintEngine::DirtyTransform )
+    {
+        const auto m = r.transform;
+        data.transform.setMatrix( m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8] );
+    }
+
+    data.isClipEnabled = r.isClipEnabled;
+    data.renderHints = static_cast< QPainter::RenderHints >( r.renderHints );
+    data.compositionMode = static_cast< QPainter::CompositionMode >( r.compositionMode );
+    data.opacity = r.opacity;
+
+    return data;
+}
+
+static QPainterPath qskPath( const ElementRecord* elements,
+    int count, Qt::FillRule fillRule )
+{
+    QPainterPath path;
+    path.setFillRule( fillRule );
+    path.reserve( count );
+
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto& e = elements[ i ];
+
+        switch ( e.type )
+        {
+            case QPainterPath::MoveToElement:
+            {
+                path.moveTo( e.x, e.y );
+                break;
+            }
+            case QPainterPath::LineToElement:
+            {
+                path.lineTo( e.x, e.y );
+                break;
+            }
+            case QPainterPath::CurveToElement:
+            {
+                if ( i + 2 < count )
+                {
+                    const auto& e2 = elements[ i + 1 ];
+                    const auto& e3 = elements[ i + 2 ];
+
+                    path.cubicTo( e.x, e.y, e2.x, e2.y, e3.x, e3.y );
+                    i += 2;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return path;
+}
+
+namespace
+{
+    class BlobWriter
+    {
+      public:
+        template< typename T, typename Writer >
+        quint32 append( const T& data, Writer writer )
+        {
+            const auto offset = m_data.size();
+
+            QDataStream stream( &m_data, QIODevice::WriteOnly | QIODevice::Append );
+            stream.setVersion( qskDataStreamVersion );
+            stream.setByteOrder( QDataStream::BigEndian );
+
+            writer( data, stream );
+
+            m_size = m_data.size() - offset;
+            return static_cast< quint32 >( offset );
+        }
+
+        quint32 lastSize() const { return static_cast< quint32 >( m_size ); }
+        const QByteArray& data() const { return m_data; }
+
+      private:
+        QByteArray m_data;
+        int m_size = 0;
+    };
+
+    class BlobReader
+    {
+      public:
+        BlobReader( const char* data, quint32 size )
+            : m_data( QByteArray::fromRawData( data, static_cast< int >( size ) ) )
+            , m_stream( m_data )
+        {
+            m_stream.setVersion( qskDataStreamVersion );
+            m_stream.setByteOrder( QDataStream::BigEndian );
+        }
+
+        QDataStream& stream() { return m_stream; }
+
+        bool isValid() const { return m_stream.status() == QDataStream::Ok; }
+
+      private:
+        const QByteArray m_data;
+        QDataStream m_stream;
+    };
+}
+
+static QByteArray qskMappableData( const QskGraphic& graphic )
+{
+    const auto& cmds = graphic.commands();
+
+    QVector< CommandRecord > commands;
+    QVector< PathRecord > paths;
+    QVector< ElementRecord > elements;
+    QVector< StateRecord > states;
+    BlobWriter blobs;
+
+    commands.reserve( cmds.size() );
+
+    for ( const auto& cmd : cmds )
+    {
+        CommandRecord command;
+        memset( &command, 0, sizeof( command ) );
+
+        command.type = static_cast< quint32 >( cmd.type() );
+
+        switch ( cmd.type() )
+        {
+            case QskPainterCommand::Path:
+            {
+                const auto& path = *cmd.path();
+
+                PathRecord pathRecord;
+                memset( &pathRecord, 0, sizeof( pathRecord ) );
+
+                pathRecord.firstElement = static_cast< quint32 >( elements.size() );
+                pathRecord.elementCount = static_cast< quint32 >( path.elementCount() );
+                pathRecord.fillRule = static_cast< quint32 >( path.fillRule() );
+
+                for ( int i = 0; i < path.elementCount(); i++ )
+                {
+                    const auto e = path.elementAt( i );
+
+                    const ElementRecord elementRecord =
+                        { e.x, e.y, static_cast< qint32 >( e.type ), 0 };
+
+                    elements += elementRecord;
+                }
+
+                command.index = static_cast< quint32 >( paths.size() );
+                paths += pathRecord;
+
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            {
+                command.index = blobs.append( *cmd.pixmapData(), qskWritePixmapData );
+                command.size = blobs.lastSize();
+
+                break;
+            }
+            case QskPainterCommand::Image:
+            {
+                command.index = blobs.append( *cmd.imageData(), qskWriteImageData );
+                command.size = blobs.lastSize();
+
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                const auto& stateData = *cmd.stateData();
+
+                StateRecord stateRecord;
+
+                if ( qskIsFlatState( stateData ) )
+                {
+                    stateRecord = qskStateRecord( stateData );
+                }
+                else
+                {
+                    memset( &stateRecord, 0, sizeof( stateRecord ) );
+
+                    stateRecord.blobOffset = blobs.append( stateData, qskWriteStateData );
+                    stateRecord.blobSize = blobs.lastSize();
+                }
+
+                command.index = static_cast< quint32 >( states.size() );
+                states += stateRecord;
+
+                break;
+            }
+            default:
+                return QByteArray();
+        }
+
+        commands += command;
+    }
+
+    QVector< AreaRecord > areas;
+    QVector< float > vertices;
+
+    const auto tessellation = graphic.tessellation();
+    if ( !tessellation.isNull() )
+    {
+        areas.reserve( tessellation.areas().size() );
+        vertices.reserve( 2 * tessellation.vertexCount() );
+
+        for ( const auto& area : tessellation.areas() )
+        {
+            const AreaRecord areaRecord = { area.color, area.opacity,
+                static_cast< quint32 >( vertices.size() / 2 ),
+                static_cast< quint32 >( area.vertices.size() / 2 ) };
+
+            areas += areaRecord;
+            vertices += area.vertices;
+        }
+    }
+
+    Header header;
+    memset( &header, 0, sizeof( header ) );
+
+    memcpy( header.magicNumber, qskMappableMagicNumber, 4 );
+    header.byteOrderMark = ByteOrderMark;
+    header.version = MappableVersion;
+
+    const auto viewBox = graphic.viewBox();
+    header.viewBox[ 0 ] = viewBox.x();
+    header.viewBox[ 1 ] = viewBox.y();
+    header.viewBox[ 2 ] = viewBox.width();
+    header.viewBox[ 3 ] = viewBox.height();
+
+    int offset = qskAligned( static_cast< int >( sizeof( Header ) ) );
+
+    auto layout = [ &offset ]( Section& section, int count, int recordSize )
+    {
+        section.offset = static_cast< quint32 >( offset );
+        section.count = static_cast< quint32 >( count );
+
+        offset = qskAligned( offset + count * recordSize );
+    };
+
+    layout( header.commands, commands.size(), sizeof( CommandRecord ) );
+    layout( header.paths, paths.size(), sizeof( PathRecord ) );
+    layout( header.elements, elements.size(), sizeof( ElementRecord ) );
+    layout( header.states, states.size(), sizeof( StateRecord ) );
+    layout( header.blobs, blobs.data().size(), 1 );
+    layout( header.areas, areas.size(), sizeof( AreaRecord ) );
+    layout( header.vertices, vertices.size() / 2, 2 * sizeof( float ) );
+
+    QByteArray data( offset, '\0' );
+
+    auto copy = [ &data ]( const Section& section, const void* values, int recordSize )
+    {
+        if ( section.count > 0 )
+            memcpy( data.data() + section.offset, values, section.count * recordSize );
+    };
+
+    memcpy( data.data(), &header, sizeof( Header ) );
+    copy( header.commands, commands.constData(), sizeof( CommandRecord ) );
+    copy( header.paths, paths.constData(), sizeof( PathRecord ) );
+    copy( header.elements, elements.constData(), sizeof( ElementRecord ) );
+    copy( header.states, states.constData(), sizeof( StateRecord ) );
+    copy( header.blobs, blobs.data().constData(), 1 );
+    copy( header.areas, areas.constData(), sizeof( AreaRecord ) );
+    copy( header.vertices, vertices.constData(), 2 * sizeof( float ) );
+
+    return data;
+}
+
+static QskGraphic qskReadMappableData( const uchar* data, qint64 size )
+{
+    /*
+        data has to be aligned to 8 bytes, what is always the case
+        for memory mapped files
+     */
+
+    if ( size < qint64( sizeof( Header ) ) )
+    {
+        qWarning( "QskGraphicIO::read: truncated data" );
+        return QskGraphic();
+    }
+
+    Header header;
+    memcpy( &header, data, sizeof( Header ) );
+
+    if ( header.byteOrderMark != ByteOrderMark )
+    {
+        qWarning( "QskGraphicIO::read: data has been written with a different byte order" );
+        return QskGraphic();
+    }
+
+    if ( header.version != MappableVersion )
+    {
+        qWarning( "QskGraphicIO::read: unsupported version %u", header.version );
+        return QskGraphic();
+    }
+
+    auto isValid = [ size ]( const Section& section, qint64 recordSize )
+    {
+        return ( section.offset % 8 == 0 )
+            && ( section.offset + section.count * recordSize <= size );
+    };
+
+    if ( !( isValid( header.commands, sizeof( CommandRecord ) )
+        && isValid( header.paths, sizeof( PathRecord ) )
+        && isValid( header.elements, sizeof( ElementRecord ) )
+        && isValid( header.states, sizeof( StateRecord ) )
+        && isValid( header.blobs, 1 )
+        && isValid( header.areas, sizeof( AreaRecord ) )
+        && isValid( header.vertices, 2 * sizeof( float ) ) ) )
+    {
+        qWarning( "QskGraphicIO::read: corrupted data" );
+        return QskGraphic();
+    }
+
+    const auto commandRecords =
+        reinterpret_cast< const CommandRecord* >( data + header.commands.offset );
+
+    const auto pathRecords =
+        reinterpret_cast< const PathRecord* >( data + header.paths.offset );
+
+    const auto elementRecords =
+        reinterpret_cast< const ElementRecord* >( data + header.elements.offset );
+
+    const auto stateRecords =
+        reinterpret_cast< const StateRecord* >( data + header.states.offset );
+
+    const auto blobs = reinterpret_cast< const char* >( data + header.blobs.offset );
+
+    auto isBlob = [ &header ]( quint32 offset, quint32 size )
+    {
+        return qint64( offset ) + size <= header.blobs.count;
+    };
+
+    QVector< QskPainterCommand > commands;
+    commands.reserve( header.commands.count );
+
+    for ( quint32 i = 0; i < header.commands.count; i++ )
+    {
+        const auto& command = commandRecords[ i ];
+
+        bool ok = false;
+
+        switch ( command.type )
+        {
+            case QskPainterCommand::Path:
+            {
+                if ( command.index < header.paths.count )
+                {
+                    const auto& p = pathRecords[ command.index ];
+
+                    if ( qint64( p.firstElement ) + p.elementCount <= header.elements.count )
+                    {
+                        const auto path = qskPath( elementRecords + p.firstElement,
+                            p.elementCount, static_cast< Qt::FillRule >( p.fillRule ) );
+
+                        commands += QskPainterCommand( path );
+                        ok = true;
+                    }
+                }
+                break;
+            }
+            case QskPainterCommand::Pixmap:
+            case QskPainterCommand::Image:
+            {
+                if ( isBlob( command.index, command.size ) )
+                {
+                    BlobReader reader( blobs + command.index, command.size );
+
+                    if ( command.type == QskPainterCommand::Pixmap )
+                        qskReadPixmapData( reader.stream(), commands );
+                    else
+                        qskReadImageData( reader.stream(), commands );
+
+                    ok = reader.isValid();
+                }
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                if ( command.index < header.states.count )
+                {
+                    const auto& r = stateRecords[ command.index ];
+
+                    if ( r.blobSize == 0 )
+                    {
+                        commands += QskPainterCommand( qskStateData( r ) );
+                        ok = true;
+                    }
+                    else if ( isBlob( r.blobOffset, r.blobSize ) )
+                    {
+                        BlobReader reader( blobs + r.blobOffset, r.blobSize );
+                        qskReadStateData( reader.stream(), commands );
+
+                        ok = reader.isValid();
+                    }
+                }
+                break;
+            }
+            default:
+                break;
+        }
+
+        if ( !ok )
+        {
+            qWarning( "QskGraphicIO::read: corrupted data" );
+            return QskGraphic();
+        }
+    }
+
+    QVector< QskGraphicTessellation::Area > areas;
+    areas.reserve( header.areas.count );
+
+    const auto areaRecords =
+        reinterpret_cast< const AreaRecord* >( data + header.areas.offset );
+
+    const auto vertices =
+        reinterpret_cast< const float* >( data + header.vertices.offset );
+
+    for ( quint32 i = 0; i < header.areas.count; i++ )
+    {
+        const auto& r = areaRecords[ i ];
+
+        if ( qint64( r.firstVertex ) + r.vertexCount > header.vertices.count )
+        {
+            qWarning( "QskGraphicIO::read: corrupted data" );
+            return QskGraphic();
+        }
+
+        const auto from = vertices + 2 * r.firstVertex;
+
+        QskGraphicTessellation::Area area;
+        area.color = r.color;
+        area.opacity = r.opacity;
+        area.vertices = QVector< float >( from, from + 2 * r.vertexCount );
+
+        areas += area;
+    }
+
+    QskGraphic graphic;
+    graphic.setViewBox( QRectF( header.viewBox[ 0 ], header.viewBox[ 1 ],
+        header.viewBox[ 2 ], header.viewBox[ 3 ] ) );
+    graphic.setCommands( commands );
+
+    if ( !areas.isEmpty() )
+        graphic.setTessellation( QskGraphicTessellation( areas ) );
+
+    return graphic;
+}
+
+static QskGraphic qskReadMappableData( const QByteArray& data )
+{
+    const auto ptr = reinterpret_cast< const uchar* >( data.constData() );
+
+    if ( reinterpret_cast< quintptr >( ptr ) % 8 == 0 )
+        return qskReadMappableData( ptr, data.size() );
+
+    // the records can't be accessed in place
+    QVector< quint64 > buffer( ( data.size() + 7 ) / 8 );
+    memcpy( buffer.data(), data.constData(), data.size() );
+
+    return qskReadMappableData(
+        reinterpret_cast< const uchar* >( buffer.constData() ), data.size() );
+}
+
 QskGraphic QskGraphicIO::read( const QString& fileName )
 {
     QFile file( fileName );
@@ -211,11 +934,28 @@ QskGraphic QskGraphicIO::read( const QString& fileName )
         return QskGraphic();
     }
 
+    const auto magicNumber = file.peek( 4 );
+    if ( qskIsMappableData( magicNumber.constData(), magicNumber.size() ) )
+    {
+        const auto size = file.size();
+
+        if ( const auto data = file.map( 0, size ) )
+        {
+            const auto graphic = qskReadMappableData( data, size );
+            file.unmap( data );
+
+            return graphic;
+        }
+    }
+
     return read( &file );
 }
 
 QskGraphic QskGraphicIO::read( const QByteArray& data )
 {
+    if ( qskIsMappableData( data.constData(), data.size() ) )
+        return qskReadMappableData( data );
+
     QBuffer buffer;
     buffer.setData( data );
 
@@ -227,6 +967,12 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     if ( dev == nullptr )
         return QskGraphic();
 
+    {
+        const auto magicNumber = dev->peek( 4 );
+        if ( qskIsMappableData( magicNumber.constData(), magicNumber.size() ) )
+            return qskReadMappableData( dev->readAll() );
+    }
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
@@ -289,7 +1035,8 @@ QskGraphic QskGraphicIO::read( QIODevice* dev )
     return graphic;
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    const QString& fileName, Format format )
 {
     QFile file( fileName );
     if ( file.open( QIODevice::WriteOnly | QIODevice::Truncate ) == false )
@@ -298,20 +1045,34 @@ bool QskGraphicIO::write( const QskGraphic& graphic, const QString& fileName )
         return false;
     }
 
-    return write( graphic, &file );
+    return write( graphic, &file, format );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QByteArray& data )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QByteArray& data, Format format )
 {
     QBuffer buffer( &data );
-    return write( graphic, &buffer );
+    return write( graphic, &buffer, format );
 }
 
-bool QskGraphicIO::write( const QskGraphic& graphic, QIODevice* dev )
+bool QskGraphicIO::write( const QskGraphic& graphic,
+    QIODevice* dev, Format format )
 {
     if ( dev == nullptr )
         return false;
 
+    if ( format == MappableFormat )
+    {
+        const auto data = qskMappableData( graphic );
+        if ( data.isEmpty() )
+            return false;
+
+        if ( !dev->isOpen() && !dev->open( QIODevice::WriteOnly ) )
+            return false;
+
+        return dev->write( data ) == data.size();
+    }
+
     QDataStream stream( dev );
 #if 1
     stream.setVersion( qskDataStreamVersion );
@@ -15,13 +15,39 @@ class QByteArray;
 
 namespace QskGraphicIO
 {
+    enum Format
+    {
+        /*
+            Platform independent format, that is written/read
+            by QDataStream
+         */
+        StreamFormat = 1,
+
+        /*
+            Flat arrays of path elements and state records in native
+            byte order, that can be used from memory mapped files without
+            decoding them element by element. The files can only be read
+            on platforms with the same byte order.
+
+            The format also includes the QskGraphic::tessellation(),
+            when being available.
+         */
+        MappableFormat = 2
+    };
+
+    // the format is detected from the magic number
     QSK_EXPORT QskGraphic read( const QString& fileName );
     QSK_EXPORT QskGraphic read( const QByteArray& data );
     QSK_EXPORT QskGraphic read( QIODevice* dev );
 
-    QSK_EXPORT bool write( const QskGraphic&, const QString& fileName );
-    QSK_EXPORT bool write( const QskGraphic&, QByteArray& data );
-    QSK_EXPORT bool write( const QskGraphic&, QIODevice* dev );
+    QSK_EXPORT bool write( const QskGraphic&,
+        const QString& fileName, Format = StreamFormat );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QByteArray& data, Format = StreamFormat );
+
+    QSK_EXPORT bool write( const QskGraphic&,
+        QIODevice* dev, Format = StreamFormat );
 }
 
 #endif
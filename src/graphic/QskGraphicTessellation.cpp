@@ -0,0 +1,168 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskGraphicTessellation.h"
+#include "QskGraphic.h"
+#include "QskPainterCommand.h"
+#include "QskInternalMacros.h"
+
+#include <qpainterpath.h>
+#include <qpen.h>
+
+QSK_QT_PRIVATE_BEGIN
+#include <private/qtriangulator_p.h>
+QSK_QT_PRIVATE_END
+
+static QVector< float > qskTriangles( const QPainterPath& path,
+    const QTransform& transform, qreal lod )
+{
+    const auto ts = qTriangulate( path, transform, lod, false );
+
+    // resolving the index buffer: see QskShapeNode
+
+    const auto xy = ts.vertices.constData();
+    const auto indices = reinterpret_cast< const quint16* >( ts.indices.data() );
+
+    QVector< float > vertices( 2 * ts.indices.size() );
+    auto v = vertices.data();
+
+    for ( int i = 0; i < ts.indices.size(); i++ )
+    {
+        const int j = 2 * indices[ i ];
+
+        *v++ = static_cast< float >( xy[ j ] );
+        *v++ = static_cast< float >( xy[ j + 1 ] );
+    }
+
+    return vertices;
+}
+
+static bool qskUpdateState( const QskPainterCommand::StateData& data,
+    QPen& pen, QBrush& brush, QTransform& transform, qreal& opacity )
+{
+    const QPaintEngine::DirtyFlags unsupportedFlags =
+        QPaintEngine::DirtyClipRegion | QPaintEngine::DirtyClipPath;
+
+    if ( data.flags & unsupportedFlags )
+        return false;
+
+    if ( ( data.flags & QPaintEngine::DirtyClipEnabled ) && data.isClipEnabled )
+        return false;
+
+    if ( data.flags & QPaintEngine::DirtyCompositionMode )
+    {
+        if ( data.compositionMode != QPainter::CompositionMode_SourceOver )
+            return false;
+    }
+
+    if ( data.flags & QPaintEngine::DirtyPen )
+        pen = data.pen;
+
+    if ( data.flags & QPaintEngine::DirtyBrush )
+        brush = data.brush;
+
+    if ( data.flags & QPaintEngine::DirtyTransform )
+        transform = data.transform;
+
+    if ( data.flags & QPaintEngine::DirtyOpacity )
+        opacity = data.opacity;
+
+    // brush origin, font, background and hints don't matter for solid paths
+
+    return true;
+}
+
+QskGraphicTessellation::QskGraphicTessellation( const QVector< Area >& areas )
+    : m_areas( areas )
+{
+    for ( const auto& area : areas )
+        m_vertexCount += area.vertices.size() / 2;
+}
+
+QskGraphicTessellation QskGraphicTessellation::tessellate( const QskGraphic& graphic )
+{
+    if ( graphic.isEmpty() || ( graphic.commandTypes() & QskGraphic::RasterData ) )
+        return QskGraphicTessellation();
+
+    qreal lod = 1.0;
+    {
+        const auto size = graphic.defaultSize();
+
+        const auto extent = qMax( size.width(), size.height() );
+        if ( extent > 0.0 )
+            lod = qMax( lod, 512.0 / extent );
+    }
+
+    const bool unscaledPens =
+        graphic.testRenderHint( QskGraphic::RenderPensUnscaled );
+
+    QPen pen;
+    QBrush brush;
+    QTransform transform;
+    qreal opacity = 1.0;
+
+    QVector< Area > areas;
+
+    for ( const auto& command : graphic.commands() )
+    {
+        switch ( command.type() )
+        {
+            case QskPainterCommand::Path:
+            {
+                const auto& path = *command.path();
+
+                if ( brush.style() != Qt::NoBrush )
+                {
+                    if ( brush.style() != Qt::SolidPattern )
+                        return QskGraphicTessellation();
+
+                    const auto vertices = qskTriangles( path, transform, lod );
+                    if ( !vertices.isEmpty() )
+                    {
+                        areas += Area { brush.color().rgba(),
+                            static_cast< float >( opacity ), vertices };
+                    }
+                }
+
+                if ( pen.style() != Qt::NoPen && pen.brush().style() != Qt::NoBrush )
+                {
+                    // the width of cosmetic or unscaled pens depends on the target size
+                    if ( pen.isCosmetic() || unscaledPens )
+                        return QskGraphicTessellation();
+
+                    if ( pen.brush().style() != Qt::SolidPattern )
+                        return QskGraphicTessellation();
+
+                    const QPainterPathStroker stroker( pen );
+
+                    const auto vertices = qskTriangles(
+                        stroker.createStroke( path ), transform, lod );
+
+                    if ( !vertices.isEmpty() )
+                    {
+                        areas += Area { pen.color().rgba(),
+                            static_cast< float >( opacity ), vertices };
+                    }
+                }
+
+                break;
+            }
+            case QskPainterCommand::State:
+            {
+                if ( !qskUpdateState( *command.stateData(),
+                    pen, brush, transform, opacity ) )
+                {
+                    return QskGraphicTessellation();
+                }
+
+                break;
+            }
+            default:
+                return QskGraphicTessellation();
+        }
+    }
+
+    return QskGraphicTessellation( areas );
+}
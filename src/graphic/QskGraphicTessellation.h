@@ -0,0 +1,81 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_GRAPHIC_TESSELLATION_H
+#define QSK_GRAPHIC_TESSELLATION_H
+
+#include "QskGlobal.h"
+
+#include <qcolor.h>
+#include <qvector.h>
+
+class QskGraphic;
+
+/*
+    The filled areas and outlines of the paths of a QskGraphic as
+    lists of triangles in the coordinate system of the graphic.
+
+    Graphics with a tessellation can be rendered by QskVectorGraphicNode
+    without painting them into a texture. As the triangles scale with the
+    graphic they stay crisp at any size, but the edges are not antialiased
+    unless multisampling is enabled for the window.
+
+    Only graphics, that consist of paths with solid pens and brushes
+    can be tessellated. Raster data, gradients, clipping, cosmetic pens
+    and composition modes are not supported.
+ */
+class QSK_EXPORT QskGraphicTessellation
+{
+  public:
+    class Area
+    {
+      public:
+        // the color, before applying a QskColorFilter
+        QRgb color;
+        float opacity;
+
+        // x/y pairs - like QSGGeometry::Point2D
+        QVector< float > vertices;
+    };
+
+    QskGraphicTessellation() noexcept = default;
+    QskGraphicTessellation( const QVector< Area >& );
+
+    bool isNull() const noexcept;
+
+    const QVector< Area >& areas() const noexcept;
+
+    // number of x/y pairs of all areas
+    int vertexCount() const noexcept;
+
+    /*
+        The curves are flattened with a precision, that is good enough
+        for rendering the graphic up to 512x512 pixels. A null
+        tessellation is returned for graphics with unsupported commands.
+     */
+    static QskGraphicTessellation tessellate( const QskGraphic& );
+
+  private:
+    QVector< Area > m_areas;
+    int m_vertexCount = 0;
+};
+
+inline bool QskGraphicTessellation::isNull() const noexcept
+{
+    return m_areas.isEmpty();
+}
+
+inline const QVector< QskGraphicTessellation::Area >&
+    QskGraphicTessellation::areas() const noexcept
+{
+    return m_areas;
+}
+
+inline int QskGraphicTessellation::vertexCount() const noexcept
+{
+    return m_vertexCount;
+}
+
+#endif
@@ -32,8 +32,67 @@ namespace
         QskLayoutChain::Segments rows;
         QskLayoutChain::Segments columns;
     };
+
+    /*
+        Layouts with heightForWidth/widthForHeight dependencies are
+        usually asked for several constraints in a row - f.e when
+        the enclosing layout is probing the minimum/preferred/maximum sizes.
+        Keeping the results of the last calculations avoids, that nested
+        layouts recalculate their chains again and again.
+     */
+    class ChainCache
+    {
+      public:
+        const QskLayoutChain* find(
+            Qt::Orientation orientation, int count, qreal constraint )
+        {
+            for ( int i = 0; i < m_entries.size(); i++ )
+            {
+                const auto& entry = m_entries[ i ];
+
+                if ( entry.orientation == orientation
+                    && entry.chain.count() == count
+                    && entry.chain.constraint() == constraint )
+                {
+                    if ( i > 0 )
+                        m_entries.move( i, 0 ); // most recently used first
+
+                    return &m_entries.first().chain;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void insert( Qt::Orientation orientation, const QskLayoutChain& chain )
+        {
+            if ( m_entries.size() >= MaxEntries )
+                m_entries.removeLast();
+
+            m_entries.prepend( Entry { orientation, chain } );
+        }
+
+        void clear()
+        {
+            m_entries.clear();
+        }
+
+      private:
+        enum { MaxEntries = 8 };
+
+        class Entry
+        {
+          public:
+            Qt::Orientation orientation;
+            QskLayoutChain chain;
+        };
+
+        QVector< Entry > m_entries;
+    };
 }
 
+static QskLayoutEngine2D::CacheStatistics qskTotalCacheStatistics;
+
 class QskLayoutEngine2D::PrivateData
 {
   public:
@@ -67,6 +126,9 @@ class QskLayoutEngine2D::PrivateData
     QskLayoutChain columnChain;
     QskLayoutChain rowChain;
 
+    ChainCache chainCache;
+    QskLayoutEngine2D::CacheStatistics cacheStatistics;
+
     QSizeF layoutSize;
 
     QskLayoutChain::Segments rows;
@@ -193,6 +255,9 @@ bool QskLayoutEngine2D::setExtraSpacingAt( Qt::Edges edges )
         m_data->rowChain.setFillMode( fillMode );
     }
 
+    // the cached chains have been calculated with the previous fill mode
+    m_data->chainCache.clear();
+
     m_data->layoutSize = QSize();
     m_data->rows.clear();
     m_data->columns.clear();
@@ -386,16 +451,36 @@ void QskLayoutEngine2D::setupChain( Qt::Orientation orientation,
         constraints.isEmpty() ? -1.0 : constraints.last().end();
 
     auto& chain = m_data->layoutChain( orientation );
+    auto& statistics = m_data->cacheStatistics;
 
     if ( ( chain.constraint() == constraint ) && ( chain.count() == count ) )
     {
-        return; // already up to date
+        // already up to date
+        statistics.hits++;
+        qskTotalCacheStatistics.hits++;
+
+        return;
     }
 
+    if ( auto cachedChain = m_data->chainCache.find( orientation, count, constraint ) )
+    {
+        chain = *cachedChain;
+
+        statistics.hits++;
+        qskTotalCacheStatistics.hits++;
+
+        return;
+    }
+
+    statistics.misses++;
+    qskTotalCacheStatistics.misses++;
+
     chain.reset( count, constraint );
     setupChain( orientation, constraints, chain );
     chain.finish();
 
+    m_data->chainCache.insert( orientation, chain );
+
 #if 0
     qDebug() << "==" << this << orientation << chain.count();
 
@@ -464,6 +549,7 @@ void QskLayoutEngine2D::invalidate( int what )
     {
         m_data->rowChain.invalidate();
         m_data->columnChain.invalidate();
+        m_data->chainCache.clear();
 
         m_data->layoutSize = QSize();
         m_data->rows.clear();
@@ -471,6 +557,26 @@ void QskLayoutEngine2D::invalidate( int what )
     }
 }
 
+QskLayoutEngine2D::CacheStatistics QskLayoutEngine2D::cacheStatistics() const
+{
+    return m_data->cacheStatistics;
+}
+
+void QskLayoutEngine2D::resetCacheStatistics()
+{
+    m_data->cacheStatistics = CacheStatistics();
+}
+
+QskLayoutEngine2D::CacheStatistics QskLayoutEngine2D::totalCacheStatistics()
+{
+    return qskTotalCacheStatistics;
+}
+
+void QskLayoutEngine2D::resetTotalCacheStatistics()
+{
+    qskTotalCacheStatistics = CacheStatistics();
+}
+
 QskSizePolicy::ConstraintType QskLayoutEngine2D::constraintType() const
 {
     if ( m_data->constraintType < 0 )
@@ -49,6 +49,21 @@ class QSK_EXPORT QskLayoutEngine2D
 
     void setGeometries( const QRectF& );
 
+    class CacheStatistics
+    {
+      public:
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    // statistics about reusing the results of previous chain calculations
+    CacheStatistics cacheStatistics() const;
+    void resetCacheStatistics();
+
+    // accumulated for all engines
+    static CacheStatistics totalCacheStatistics();
+    static void resetTotalCacheStatistics();
+
   protected:
     QRectF geometryAt( const QskLayoutElement*, const QRect& grid ) const;
 
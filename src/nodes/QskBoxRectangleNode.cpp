@@ -12,31 +12,290 @@
 #include "QskGradientDirection.h"
 #include "QskFillNodePrivate.h"
 
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+
 static inline bool qskHasBorder(
     const QskBoxBorderMetrics& metrics, const QskBoxBorderColors& colors )
 {
     return !metrics.isNull() && colors.isVisible();
 }
 
+static inline void qskSetBoxLines( const QRectF& rect,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics,
+    const QskBoxBorderColors& borderColors, const QskGradient& gradient,
+    QSGGeometry& geometry )
+{
+    auto fillGradient = QskBoxRenderer::effectiveGradient( gradient );
+    if ( !QskBoxRenderer::isGradientSupported( fillGradient ) )
+    {
+        qWarning() << "QskBoxRenderer does not support radial/conic gradients";
+        fillGradient.setDirection( QskGradient::Linear );
+    }
+
+    QskBoxRenderer renderer;
+    renderer.setColoredBorderAndFillLines( rect, shape, borderMetrics,
+        borderColors, fillGradient, geometry );
+}
+
+/*
+    For colored geometries the colors are part of the vertices and we
+    need to know if they remain valid, when moving the existing lines.
+ */
+static inline bool qskIsTranslatable( const QskGradient& gradient )
+{
+    // gradients are stretched to the rectangle of the box
+    return !gradient.isVisible() || gradient.isMonochrome()
+        || ( gradient.stretchMode() == QskGradient::StretchToSize );
+}
+
+static inline bool qskIsResizable( const QskGradient& gradient )
+{
+    return !gradient.isVisible() || gradient.isMonochrome();
+}
+
+static inline bool qskIsResizable( const QskBoxBorderColors& colors )
+{
+    // gradient lines would be in the middle of the edges
+    return !colors.isVisible() || colors.isMonochrome();
+}
+
+namespace
+{
+    enum GeometryUpdate
+    {
+        NoUpdate,
+
+        // moving the lines of the existing geometry
+        Translation,
+        Resizing,
+
+        // creating the lines from scratch
+        Tessellation
+    };
+
+    enum GeometryType
+    {
+        FillGeometry,
+        BorderGeometry,
+        BoxGeometry
+    };
+
+    class GeometryKey
+    {
+      public:
+        inline bool operator==( const GeometryKey& other ) const
+        {
+            return ( type == other.type ) && ( colored == other.colored )
+                && ( metricsHash == other.metricsHash )
+                && ( colorsHash == other.colorsHash ) && ( rect == other.rect );
+        }
+
+        QRectF rect;
+
+        QskHashValue metricsHash;
+        QskHashValue colorsHash;
+
+        GeometryType type;
+        bool colored;
+    };
+
+    inline QskHashValue qHash( const GeometryKey& key, QskHashValue seed = 0 )
+    {
+        auto hash = qHashBits( &key.rect, sizeof( key.rect ), seed );
+        hash = qHash( key.metricsHash, hash );
+        hash = qHash( key.colorsHash, hash );
+
+        return qHash( 2 * key.type + key.colored, hash );
+    }
+
+    class SharedGeometry
+    {
+      public:
+        inline SharedGeometry( const GeometryKey& key )
+            : geometry( key.colored
+                ? QSGGeometry::defaultAttributes_ColoredPoint2D()
+                : QSGGeometry::defaultAttributes_Point2D(), 0 )
+            , key( key )
+        {
+        }
+
+        QSGGeometry geometry;
+        const GeometryKey key;
+
+        int refCount = 1;
+    };
+
+    /*
+        Identical boxes - f.e the backgrounds of all buttons in a toolbar - can
+        share the same geometry. As the nodes of different windows might be
+        updated from different render threads the cache needs to be locked.
+
+        A geometry is removed from the cache as soon as it is not in use anymore.
+     */
+    class GeometryCache
+    {
+      public:
+        SharedGeometry* acquire( const GeometryKey& key )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            auto geometry = m_geometries.value( key, nullptr );
+            if ( geometry )
+                geometry->refCount++;
+
+            return geometry;
+        }
+
+        SharedGeometry* insert( SharedGeometry* geometry )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            auto& entry = m_geometries[ geometry->key ];
+            if ( entry )
+            {
+                // another render thread has been faster
+                delete geometry;
+                entry->refCount++;
+            }
+            else
+            {
+                entry = geometry;
+            }
+
+            return entry;
+        }
+
+        void release( SharedGeometry* geometry )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            if ( --geometry->refCount == 0 )
+            {
+                m_geometries.remove( geometry->key );
+                delete geometry;
+            }
+        }
+
+      private:
+        QMutex m_mutex;
+        QHash< GeometryKey, SharedGeometry* > m_geometries;
+    };
+}
+
+Q_GLOBAL_STATIC( GeometryCache, qskGeometryCache )
+
 class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
 {
   public:
+    inline ~QskBoxRectangleNodePrivate()
+    {
+        if ( m_sharedGeometry )
+            qskGeometryCache->release( m_sharedGeometry );
+    }
+
     inline void resetNode( QskBoxRectangleNode* node )
     {
         m_metricsHash = m_colorsHash = 0;
+        m_rect = m_previousRect = QRectF();
+        m_adjustmentCount = 0;
+
+        unshareGeometry( node );
         node->resetGeometry();
     }
 
-    inline bool updateMetrics( const QRectF& rect,
+    template< typename Tessellator >
+    void shareGeometry( QskBoxRectangleNode* node,
+        GeometryType type, Tessellator tessellate )
+    {
+        GeometryKey key;
+        key.rect = m_rect;
+        key.metricsHash = m_metricsHash;
+        key.type = type;
+        key.colored = node->isGeometryColored();
+
+        // otherwise the colors are in the material
+        key.colorsHash = key.colored ? m_colorsHash : 0;
+
+        if ( m_sharedGeometry && m_sharedGeometry->key == key )
+            return;
+
+        auto sharedGeometry = qskGeometryCache->acquire( key );
+        if ( sharedGeometry == nullptr )
+        {
+            sharedGeometry = new SharedGeometry( key );
+            tessellate( sharedGeometry->geometry );
+
+            sharedGeometry = qskGeometryCache->insert( sharedGeometry );
+        }
+
+        if ( m_sharedGeometry )
+            qskGeometryCache->release( m_sharedGeometry );
+
+        m_sharedGeometry = sharedGeometry;
+
+        node->setGeometry( &m_sharedGeometry->geometry );
+        node->markDirty( QSGNode::DirtyGeometry );
+    }
+
+    inline bool unshareGeometry( QskBoxRectangleNode* node )
+    {
+        if ( m_sharedGeometry == nullptr )
+            return false;
+
+        qskGeometryCache->release( m_sharedGeometry );
+        m_sharedGeometry = nullptr;
+
+        // the own geometry has not been updated while sharing
+        geometry.allocate( 0 );
+
+        node->setGeometry( &geometry );
+        node->markDirty( QSGNode::DirtyGeometry );
+
+        return true;
+    }
+
+    inline GeometryUpdate updateMetrics( const QRectF& rect,
         const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& borderMetrics )
     {
+        /*
+            The rectangle is not part of the hash, so that we can find
+            out if the existing lines can be moved instead of
+            being recalculated.
+         */
         QskHashValue hash = 13000;
 
-        hash = qHashBits( &rect, sizeof( rect ), hash );
         hash = shape.hash( hash );
         hash = borderMetrics.hash( hash );
 
-        return updateHash( m_metricsHash, hash );
+        m_previousRect = m_rect;
+        m_rect = rect;
+
+        if ( updateHash( m_metricsHash, hash ) )
+            return tessellation();
+
+        if ( rect == m_previousRect )
+            return NoUpdate;
+
+        /*
+            Adding offsets to the float coordinates of the vertices
+            accumulates rounding errors. So we start from scratch
+            from time to time.
+         */
+        if ( ++m_adjustmentCount > 100 )
+            return tessellation();
+
+        if ( rect.size() == m_previousRect.size() )
+            return Translation;
+
+        if ( QskBoxRenderer::isAdjustable( m_previousRect.size(),
+            rect.size(), shape, borderMetrics ) )
+        {
+            return Resizing;
+        }
+
+        return tessellation();
     }
 
     inline bool updateColors(
@@ -53,6 +312,19 @@ class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
         return updateHash( m_colorsHash, hash );
     }
 
+    inline void adjustLines( const QskBoxShapeMetrics& shape,
+        const QskBoxBorderMetrics& borderMetrics, QSGGeometry& geometry )
+    {
+        QskBoxRenderer renderer;
+        renderer.adjustLines( m_previousRect, m_rect, shape, borderMetrics, geometry );
+    }
+
+    inline GeometryUpdate tessellation()
+    {
+        m_adjustmentCount = 0;
+        return Tessellation;
+    }
+
   private:
     inline bool updateHash( QskHashValue& value, const QskHashValue newValue ) const
     {
@@ -68,6 +340,13 @@ class QskBoxRectangleNodePrivate final : public QskFillNodePrivate
   public:
     QskHashValue m_metricsHash = 0;
     QskHashValue m_colorsHash = 0;
+
+    QRectF m_rect;
+    QRectF m_previousRect;
+
+    int m_adjustmentCount = 0;
+
+    SharedGeometry* m_sharedGeometry = nullptr;
 };
 
 QskBoxRectangleNode::QskBoxRectangleNode()
@@ -109,22 +388,71 @@ void QskBoxRectangleNode::updateFilling(
     const bool coloredGeometry = hasHint( PreferColoredGeometry )
         && QskBoxRenderer::isGradientSupported( fillGradient );
 
-    bool dirtyGeometry = d->updateMetrics( rect, shape, borderMetrics );
+    auto update = d->updateMetrics( rect, shape, borderMetrics );
     bool dirtyMaterial = d->updateColors( QskBoxBorderColors(), fillGradient );
 
     if ( coloredGeometry != isGeometryColored() )
-        dirtyGeometry = dirtyMaterial = true;
+    {
+        update = d->tessellation();
+        dirtyMaterial = true;
+    }
+
+    if ( coloredGeometry )
+    {
+        if ( dirtyMaterial
+            || ( update == Translation && !qskIsTranslatable( fillGradient ) )
+            || ( update == Resizing && !qskIsResizable( fillGradient ) ) )
+        {
+            update = d->tessellation();
+        }
+    }
 
-    if ( dirtyGeometry || dirtyMaterial )
+    if ( update != NoUpdate || dirtyMaterial )
     {
         QskBoxRenderer renderer;
 
+        if ( hasHint( PreferSharedGeometry ) )
+        {
+            if ( coloredGeometry )
+                setColoring( QskFillNode::Polychrome );
+            else
+                setColoring( rect, fillGradient );
+
+            if ( update != NoUpdate )
+            {
+                d->shareGeometry( this, FillGeometry, [&]( QSGGeometry& geometry )
+                {
+                    if ( coloredGeometry )
+                    {
+                        renderer.setColoredFillLines( rect, shape,
+                            borderMetrics, fillGradient, geometry );
+                    }
+                    else
+                    {
+                        renderer.setFillLines( rect, shape, borderMetrics, geometry );
+                    }
+                } );
+            }
+
+            return;
+        }
+
+        if ( d->unshareGeometry( this ) )
+            update = d->tessellation();
+
         if ( coloredGeometry )
         {
             setColoring( QskFillNode::Polychrome );
 
-            renderer.setColoredFillLines( rect, shape,
-                borderMetrics, fillGradient, *geometry() );
+            if ( update == Tessellation )
+            {
+                renderer.setColoredFillLines( rect, shape,
+                    borderMetrics, fillGradient, *geometry() );
+            }
+            else
+            {
+                d->adjustLines( shape, borderMetrics, *geometry() );
+            }
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -132,9 +460,13 @@ void QskBoxRectangleNode::updateFilling(
         {
             setColoring( rect, fillGradient );
 
-            if ( dirtyGeometry )
+            if ( update != NoUpdate )
             {
-                renderer.setFillLines( rect, shape, borderMetrics, *geometry() );
+                if ( update == Tessellation )
+                    renderer.setFillLines( rect, shape, borderMetrics, *geometry() );
+                else
+                    d->adjustLines( shape, borderMetrics, *geometry() );
+
                 markDirty( QSGNode::DirtyGeometry );
             }
         }
@@ -158,22 +490,70 @@ void QskBoxRectangleNode::updateBorder(
     const bool coloredGeometry = hasHint( PreferColoredGeometry )
         || !borderColors.isMonochrome();
 
-    bool dirtyGeometry = d->updateMetrics( rect, shape, borderMetrics );
+    auto update = d->updateMetrics( rect, shape, borderMetrics );
     bool dirtyMaterial = d->updateColors( borderColors, QskGradient() );
 
     if ( coloredGeometry != isGeometryColored() )
-        dirtyGeometry = dirtyMaterial = true;
+    {
+        update = d->tessellation();
+        dirtyMaterial = true;
+    }
 
-    if ( dirtyGeometry || dirtyMaterial )
+    if ( coloredGeometry )
+    {
+        if ( dirtyMaterial
+            || ( update == Resizing && !qskIsResizable( borderColors ) ) )
+        {
+            update = d->tessellation();
+        }
+    }
+
+    if ( update != NoUpdate || dirtyMaterial )
     {
         QskBoxRenderer renderer;
 
+        if ( hasHint( PreferSharedGeometry ) )
+        {
+            if ( coloredGeometry )
+                setColoring( QskFillNode::Polychrome );
+            else
+                setColoring( borderColors.left().rgbStart() );
+
+            if ( update != NoUpdate )
+            {
+                d->shareGeometry( this, BorderGeometry, [&]( QSGGeometry& geometry )
+                {
+                    if ( coloredGeometry )
+                    {
+                        renderer.setColoredBorderLines( rect, shape,
+                            borderMetrics, borderColors, geometry );
+                    }
+                    else
+                    {
+                        renderer.setBorderLines( rect, shape, borderMetrics, geometry );
+                    }
+                } );
+            }
+
+            return;
+        }
+
+        if ( d->unshareGeometry( this ) )
+            update = d->tessellation();
+
         if ( coloredGeometry )
         {
             setColoring( QskFillNode::Polychrome );
 
-            renderer.setColoredBorderLines( rect, shape,
-                borderMetrics, borderColors, *geometry() );
+            if ( update == Tessellation )
+            {
+                renderer.setColoredBorderLines( rect, shape,
+                    borderMetrics, borderColors, *geometry() );
+            }
+            else
+            {
+                d->adjustLines( shape, borderMetrics, *geometry() );
+            }
 
             markDirty( QSGNode::DirtyGeometry );
         }
@@ -181,10 +561,17 @@ void QskBoxRectangleNode::updateBorder(
         {
             setColoring( borderColors.left().rgbStart() );
 
-            if ( dirtyGeometry )
+            if ( update != NoUpdate )
             {
-                renderer.setBorderLines( rect, shape,
-                    borderMetrics, *geometry() );
+                if ( update == Tessellation )
+                {
+                    renderer.setBorderLines( rect, shape,
+                        borderMetrics, *geometry() );
+                }
+                else
+                {
+                    d->adjustLines( shape, borderMetrics, *geometry() );
+                }
 
                 markDirty( QSGNode::DirtyGeometry );
             }
@@ -211,10 +598,47 @@ void QskBoxRectangleNode::updateBox( const QRectF& rect,
     {
         const auto shape = shapeMetrics.toAbsolute( rect.size() );
 
-        const bool isDirty = d->updateMetrics( rect, shape, borderMetrics )
-            || d->updateColors( borderColors, gradient ) || !isGeometryColored();
+        auto update = d->updateMetrics( rect, shape, borderMetrics );
 
-        if ( isDirty )
+        if ( d->updateColors( borderColors, gradient ) || !isGeometryColored() )
+            update = d->tessellation();
+
+        if ( update == Translation )
+        {
+            if ( !qskIsTranslatable( gradient ) )
+                update = d->tessellation();
+        }
+        else if ( update == Resizing )
+        {
+            if ( !( qskIsResizable( gradient ) && qskIsResizable( borderColors ) ) )
+                update = d->tessellation();
+        }
+
+        if ( hasHint( PreferSharedGeometry ) )
+        {
+            if ( update != NoUpdate )
+            {
+                setColoring( QskFillNode::Polychrome );
+
+                d->shareGeometry( this, BoxGeometry, [&]( QSGGeometry& geometry )
+                {
+                    qskSetBoxLines( rect, shape, borderMetrics,
+                        borderColors, gradient, geometry );
+                } );
+            }
+
+            return;
+        }
+
+        if ( d->unshareGeometry( this ) )
+            update = d->tessellation();
+
+        if ( update == Translation || update == Resizing )
+        {
+            d->adjustLines( shape, borderMetrics, *geometry() );
+            markDirty( QSGNode::DirtyGeometry );
+        }
+        else if ( update == Tessellation )
         {
             /*
                 For monochrome border/filling with the same color we might be
@@ -223,16 +647,8 @@ void QskBoxRectangleNode::updateBox( const QRectF& rect,
              */
             setColoring( QskFillNode::Polychrome );
 
-            auto fillGradient = QskBoxRenderer::effectiveGradient( gradient );
-            if ( !QskBoxRenderer::isGradientSupported( fillGradient ) )
-            {
-                qWarning() << "QskBoxRenderer does not support radial/conic gradients";
-                fillGradient.setDirection( QskGradient::Linear );
-            }
-
-            QskBoxRenderer renderer;
-            renderer.setColoredBorderAndFillLines( rect, shape, borderMetrics,
-                borderColors, fillGradient, *geometry() );
+            qskSetBoxLines( rect, shape, borderMetrics,
+                borderColors, gradient, *geometry() );
 
             markDirty( QSGNode::DirtyGeometry );
         }
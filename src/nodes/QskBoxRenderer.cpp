@@ -62,6 +62,36 @@ static inline QskGradient qskEffectiveGradient(
     return g;
 }
 
+static inline QskMargins qskCornerExtents(
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
+{
+    // the space being occupied by the corners at each side of the box
+
+    const auto tl = shape.radius( Qt::TopLeftCorner );
+    const auto tr = shape.radius( Qt::TopRightCorner );
+    const auto bl = shape.radius( Qt::BottomLeftCorner );
+    const auto br = shape.radius( Qt::BottomRightCorner );
+
+    const auto& bw = border.widths();
+
+    return QskMargins(
+        qMax( bw.left(), qMax( tl.width(), bl.width() ) ),
+        qMax( bw.top(), qMax( tl.height(), tr.height() ) ),
+        qMax( bw.right(), qMax( tr.width(), br.width() ) ),
+        qMax( bw.bottom(), qMax( bl.height(), br.height() ) ) );
+}
+
+static inline bool qskHasSeparatedCorners(
+    const QSizeF& size, const QskMargins& extents )
+{
+    /*
+        No clipping of radii/borders happens in QskBoxMetrics and
+        the straight lines between the corners do not degenerate
+     */
+    return ( 2.0 * qMax( extents.left(), extents.right() ) < size.width() )
+        && ( 2.0 * qMax( extents.top(), extents.bottom() ) < size.height() );
+}
+
 static inline bool qskMaybeSpreading( const QskGradient& gradient )
 {
     if ( gradient.stretchMode() == QskGradient::StretchToSize )
@@ -117,6 +147,57 @@ bool QskBoxRenderer::isGradientSupported( const QskGradient& gradient )
     return false;
 }
 
+bool QskBoxRenderer::isAdjustable( const QSizeF& from, const QSizeF& to,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border )
+{
+    if ( from == to )
+        return true;
+
+    const auto extents = qskCornerExtents( shape, border );
+
+    return qskHasSeparatedCorners( from, extents )
+        && qskHasSeparatedCorners( to, extents );
+}
+
+void QskBoxRenderer::adjustLines( const QRectF& from, const QRectF& to,
+    const QskBoxShapeMetrics& shape, const QskBoxBorderMetrics& border,
+    QSGGeometry& geometry )
+{
+    const auto extents = qskCornerExtents( shape, border );
+
+    /*
+        All points of the left corners are left of splitX, all points
+        of the right corners are right of it. Same for splitY.
+     */
+    const auto splitX = 0.5 * ( from.left() + extents.left()
+        + from.right() - extents.right() );
+
+    const auto splitY = 0.5 * ( from.top() + extents.top()
+        + from.bottom() - extents.bottom() );
+
+    const auto dx1 = static_cast< float >( to.left() - from.left() );
+    const auto dx2 = static_cast< float >( to.right() - from.right() );
+    const auto dy1 = static_cast< float >( to.top() - from.top() );
+    const auto dy2 = static_cast< float >( to.bottom() - from.bottom() );
+
+    /*
+        Point2D and ColoredPoint2D both start with the coordinates,
+        so we only need to respect the size of the vertices.
+     */
+    auto data = static_cast< char* >( geometry.vertexData() );
+    const int stride = geometry.sizeOfVertex();
+
+    for ( int i = 0; i < geometry.vertexCount(); i++ )
+    {
+        auto point = reinterpret_cast< QSGGeometry::Point2D* >( data + i * stride );
+
+        point->x += ( point->x < splitX ) ? dx1 : dx2;
+        point->y += ( point->y < splitY ) ? dy1 : dy2;
+    }
+
+    geometry.markVertexDataDirty();
+}
+
 void QskBoxRenderer::setBorderLines(
     const QRectF& rect, const QskBoxShapeMetrics& shape,
     const QskBoxBorderMetrics& border, QSGGeometry& geometry )
@@ -15,6 +15,7 @@ class QskGradient;
 
 class QSGGeometry;
 class QRectF;
+class QSizeF;
 
 class QSK_EXPORT QskBoxRenderer
 {
@@ -58,6 +59,22 @@ class QSK_EXPORT QskBoxRenderer
         const QskBoxShapeMetrics&, const QskBoxBorderMetrics&,
         const QskBoxBorderColors&, const QskGradient&, QSGGeometry& );
 
+    /*
+        Moving the lines of a geometry, that has been created for the same
+        shape/border metrics, to another rectangle. Colors are not touched.
+
+        This is possible for any translation, but when the size changes
+        only as long as the corners of the box do not overlap. Then the
+        points of each corner can be moved as a whole and only the straight
+        lines between them get stretched.
+     */
+
+    static bool isAdjustable( const QSizeF& from, const QSizeF& to,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics& );
+
+    void adjustLines( const QRectF& from, const QRectF& to,
+        const QskBoxShapeMetrics&, const QskBoxBorderMetrics&, QSGGeometry& );
+
     static bool isGradientSupported( const QskGradient& );
     static QskGradient effectiveGradient( const QskGradient& );
 };
@@ -13,6 +13,8 @@ QSK_QT_PRIVATE_BEGIN
 QSK_QT_PRIVATE_END
 
 #include <qcoreapplication.h>
+#include <qhash.h>
+#include <qmutex.h>
 
 namespace
 {
@@ -30,6 +32,8 @@ namespace
             const int size = qBound( 256, 2 * stops.count(), 1024 );
             setImage( QskRgb::colorTable( size, stops ) );
 
+            m_bytes = size * 4;
+
             const auto wrapMode = this->wrapMode( spreadMode );
 
             setHorizontalWrapMode( wrapMode );
@@ -38,6 +42,8 @@ namespace
             setFiltering( QSGTexture::Linear );
         }
 
+        inline qint64 bytes() const { return m_bytes; }
+
       private:
         static inline QSGTexture::WrapMode wrapMode( QskGradient::SpreadMode spreadMode )
         {
@@ -53,22 +59,23 @@ namespace
                     return QSGTexture::ClampToEdge;
             }
         }
+
+        qint64 m_bytes;
     };
 
-    class HashKey
+    class RampKey
     {
       public:
-        inline bool operator==( const HashKey& other ) const
+        inline bool operator==( const RampKey& other ) const
         {
-            return rhi == other.rhi && spreadMode == other.spreadMode && stops == other.stops;
+            return spreadMode == other.spreadMode && stops == other.stops;
         }
 
-        const void* rhi;
-        const QskGradientStops stops;
-        const QskGradient::SpreadMode spreadMode;
+        QskGradientStops stops;
+        QskGradient::SpreadMode spreadMode;
     };
 
-    inline size_t qHash( const HashKey& key, size_t seed = 0 )
+    inline size_t qHash( const RampKey& key, size_t seed = 0 )
     {
         size_t values = seed + key.spreadMode;
 
@@ -78,19 +85,71 @@ namespace
         return values;
     }
 
+    class HashKey
+    {
+      public:
+        inline bool operator==( const HashKey& other ) const
+        {
+            return rhi == other.rhi && ramp == other.ramp;
+        }
+
+        const void* rhi;
+        RampKey ramp;
+    };
+
+    inline size_t qHash( const HashKey& key, size_t seed = 0 )
+    {
+        return qHash( key.ramp, seed );
+    }
+
+    class Entry
+    {
+      public:
+        Texture* texture;
+        qint64 bytes;
+
+        // for finding the least recently used entries
+        quint64 lastUsed;
+    };
+
     class Cache
     {
       public:
-        ~Cache() { qDeleteAll( m_hashTable ); }
+        ~Cache();
 
         void cleanupRhi( const QRhi* );
 
         Texture* texture( const void* rhi,
             const QskGradientStops&, QskGradient::SpreadMode );
 
+        void ref( const QskGradientStops&, QskGradient::SpreadMode );
+        void deref( const QskGradientStops&, QskGradient::SpreadMode );
+
+        void setMaxEntries( int );
+        int maxEntries();
+
+        void setMaxBytes( qint64 );
+        qint64 maxBytes();
+
+        QskColorRamp::Statistics statistics();
+        void resetStatistics();
+
       private:
-        QHash< HashKey, Texture* > m_hashTable;
+        void evict();
+
+        QMutex m_mutex;
+
+        QHash< HashKey, Entry > m_hashTable;
         QVector< const QRhi* > m_rhiTable; // no QSet: we usually have only one entry
+
+        // number of materials using a ramp
+        QHash< RampKey, int > m_references;
+
+        int m_maxEntries = 256;
+        qint64 m_maxBytes = 2 * 1024 * 1024;
+
+        quint64 m_usageCounter = 0;
+        QskColorRamp::Statistics m_statistics;
     };
 
     static Cache* s_cache;
@@ -108,39 +167,181 @@ static void qskCleanupRhi( const QRhi* rhi )
         s_cache->cleanupRhi( rhi );
 }
 
+static inline Cache* qskCache()
+{
+    if ( s_cache == nullptr )
+    {
+        s_cache = new Cache();
+
+        /*
+            For RHI we have QRhi::addCleanupCallback, but with
+            OpenGL we would have to fiddle around with QOpenGLSharedResource
+            But as the OpenGL path is only for Qt5 we do not want to spend
+            much energy on finetuning the resource management.
+         */
+        qAddPostRoutine( qskCleanupCache );
+    }
+
+    return s_cache;
+}
+
+Cache::~Cache()
+{
+    for ( const auto& entry : std::as_const( m_hashTable ) )
+        delete entry.texture;
+}
+
 Texture* Cache::texture( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
-    const HashKey key { rhi, stops, spreadMode };
+    const QMutexLocker locker( &m_mutex );
+
+    const HashKey key { rhi, { stops, spreadMode } };
 
-    auto texture = m_hashTable[key];
-    if ( texture == nullptr )
+    auto it = m_hashTable.find( key );
+    if ( it != m_hashTable.end() )
     {
-        texture = new Texture( stops, spreadMode );
-        m_hashTable[ key ] = texture;
+        it->lastUsed = ++m_usageCounter;
+        m_statistics.hits++;
 
-        if ( rhi != nullptr )
-        {
-            auto myrhi = ( QRhi* )rhi;
+        return it->texture;
+    }
 
-            if ( !m_rhiTable.contains( myrhi ) )
-            {
-                myrhi->addCleanupCallback( qskCleanupRhi );
-                m_rhiTable += myrhi;
-            }
+    m_statistics.misses++;
+
+    auto texture = new Texture( stops, spreadMode );
+
+    const Entry entry { texture, texture->bytes(), ++m_usageCounter };
+    m_hashTable.insert( key, entry );
+
+    m_statistics.entries++;
+    m_statistics.bytes += entry.bytes;
+
+    if ( rhi != nullptr )
+    {
+        auto myrhi = ( QRhi* )rhi;
+
+        if ( !m_rhiTable.contains( myrhi ) )
+        {
+            myrhi->addCleanupCallback( qskCleanupRhi );
+            m_rhiTable += myrhi;
         }
     }
 
+    evict();
+
     return texture;
 }
 
+void Cache::evict()
+{
+    /*
+        The number of entries is small and evicting happens only
+        when creating a new texture. So a linear search for the least
+        recently used entry is good enough.
+     */
+    while ( ( m_statistics.entries > m_maxEntries )
+        || ( m_statistics.bytes > m_maxBytes ) )
+    {
+        auto lru = m_hashTable.end();
+
+        for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); ++it )
+        {
+            if ( it->lastUsed == m_usageCounter )
+                continue; // the texture, that has just been requested
+
+            if ( m_references.value( it.key().ramp ) > 0 )
+                continue;
+
+            if ( lru == m_hashTable.end() || it->lastUsed < lru->lastUsed )
+                lru = it;
+        }
+
+        if ( lru == m_hashTable.end() )
+            break; // all ramps are in use
+
+        m_statistics.entries--;
+        m_statistics.bytes -= lru->bytes;
+        m_statistics.evictions++;
+
+        delete lru->texture;
+        m_hashTable.erase( lru );
+    }
+}
+
+void Cache::ref( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    const QMutexLocker locker( &m_mutex );
+    m_references[ { stops, spreadMode } ]++;
+}
+
+void Cache::deref( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    const QMutexLocker locker( &m_mutex );
+
+    auto it = m_references.find( { stops, spreadMode } );
+    if ( it != m_references.end() )
+    {
+        if ( --( *it ) <= 0 )
+            m_references.erase( it );
+    }
+}
+
+void Cache::setMaxEntries( int maxEntries )
+{
+    const QMutexLocker locker( &m_mutex );
+
+    m_maxEntries = qMax( maxEntries, 1 );
+    evict();
+}
+
+int Cache::maxEntries()
+{
+    const QMutexLocker locker( &m_mutex );
+    return m_maxEntries;
+}
+
+void Cache::setMaxBytes( qint64 maxBytes )
+{
+    const QMutexLocker locker( &m_mutex );
+
+    m_maxBytes = qMax( maxBytes, qint64( 0 ) );
+    evict();
+}
+
+qint64 Cache::maxBytes()
+{
+    const QMutexLocker locker( &m_mutex );
+    return m_maxBytes;
+}
+
+QskColorRamp::Statistics Cache::statistics()
+{
+    const QMutexLocker locker( &m_mutex );
+    return m_statistics;
+}
+
+void Cache::resetStatistics()
+{
+    const QMutexLocker locker( &m_mutex );
+
+    m_statistics.hits = 0;
+    m_statistics.misses = 0;
+    m_statistics.evictions = 0;
+}
+
 void Cache::cleanupRhi( const QRhi* rhi )
 {
+    const QMutexLocker locker( &m_mutex );
+
     for ( auto it = m_hashTable.begin(); it != m_hashTable.end(); )
     {
         if ( it.key().rhi == rhi )
         {
-            delete it.value();
+            m_statistics.entries--;
+            m_statistics.bytes -= it->bytes;
+
+            delete it->texture;
             it = m_hashTable.erase( it );
         }
         else
@@ -155,18 +356,50 @@ void Cache::cleanupRhi( const QRhi* rhi )
 QSGTexture* QskColorRamp::texture( const void* rhi,
     const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
 {
-    if ( s_cache == nullptr )
-    {
-        s_cache = new Cache();
+    return qskCache()->texture( rhi, stops, spreadMode );
+}
 
-        /*
-            For RHI we have QRhi::addCleanupCallback, but with
-            OpenGL we would have to fiddle around with QOpenGLSharedResource
-            But as the OpenGL path is only for Qt5 we do not want to spend
-            much energy on finetuning the resource management.
-         */
-        qAddPostRoutine( qskCleanupCache );
-    }
+void QskColorRamp::ref( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    qskCache()->ref( stops, spreadMode );
+}
 
-    return s_cache->texture( rhi, stops, spreadMode );
+void QskColorRamp::deref( const QskGradientStops& stops, QskGradient::SpreadMode spreadMode )
+{
+    if ( s_cache )
+        s_cache->deref( stops, spreadMode );
+}
+
+void QskColorRamp::setMaxEntries( int maxEntries )
+{
+    qskCache()->setMaxEntries( maxEntries );
+}
+
+int QskColorRamp::maxEntries()
+{
+    return qskCache()->maxEntries();
+}
+
+void QskColorRamp::setMaxBytes( qint64 maxBytes )
+{
+    qskCache()->setMaxBytes( maxBytes );
+}
+
+qint64 QskColorRamp::maxBytes()
+{
+    return qskCache()->maxBytes();
+}
+
+QskColorRamp::Statistics QskColorRamp::statistics()
+{
+    if ( s_cache )
+        return s_cache->statistics();
+
+    return Statistics();
+}
+
+void QskColorRamp::resetStatistics()
+{
+    if ( s_cache )
+        s_cache->resetStatistics();
 }
@@ -11,10 +11,48 @@
 
 class QSGTexture;
 
+/*
+    Textures for the colors of gradients, that are shared between all
+    gradient materials.
+
+    The number of textures ( and the memory in use ) is limited. Once
+    reaching the limits, the least recently used ramps are evicted - as long
+    as they are not referenced by a QskGradientMaterial. So the limits
+    might be exceeded, when having many different gradients on the screen.
+ */
 namespace QskColorRamp
 {
     QSGTexture* texture( const void* rhi,
         const QskGradientStops&, QskGradient::SpreadMode );
+
+    /*
+        Protecting the textures of a ramp from being evicted,
+        while it is in use by a material
+     */
+    void ref( const QskGradientStops&, QskGradient::SpreadMode );
+    void deref( const QskGradientStops&, QskGradient::SpreadMode );
+
+    void setMaxEntries( int );
+    int maxEntries();
+
+    void setMaxBytes( qint64 );
+    qint64 maxBytes();
+
+    class Statistics
+    {
+      public:
+        int entries = 0;
+        qint64 bytes = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    Statistics statistics();
+
+    // resetting hits, misses and evictions
+    void resetStatistics();
 }
 
 #endif
@@ -33,6 +33,9 @@ static inline QskFillNode::Hints qskDefaultFillNodeHints()
     QskFillNode::Hints hints;
     if ( !qskHasEnvironment( "QSK_PREFER_SHADER_COLORS" ) )
         hints |= QskFillNode::PreferColoredGeometry;
+
+    if ( qskHasEnvironment( "QSK_SHARE_GEOMETRY" ) )
+        hints |= QskFillNode::PreferSharedGeometry;
         
     return hints;
 }
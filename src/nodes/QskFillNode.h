@@ -46,7 +46,27 @@ class QSK_EXPORT QskFillNode : public QSGGeometryNode
             The default setting is to use colored points where possible. Note, that
             this is what is also done in the Qt/Quick classes.
          */
-        PreferColoredGeometry = 1 << 0
+        PreferColoredGeometry = 1 << 0,
+
+        /*
+            Nodes with identical geometries might share them instead of
+            tessellating and storing the same vertices again. The geometry
+            is then immutable and has to be looked up/created for every update,
+            what is a good deal for uniform tiles, but not for animated boxes.
+
+            For the moment this hint is only supported by QskBoxRectangleNode.
+         */
+        PreferSharedGeometry = 1 << 1,
+
+        /*
+            Tessellating paths in a worker thread, while keeping the previous
+            geometry until the result is available. The item needs to be
+            updated again, when the result has landed: see QskTessellationMonitor
+            and QskItem::PreferAsynchronousTessellation.
+
+            For the moment this hint is only supported by QskShapeNode/QskStrokeNode.
+         */
+        PreferAsynchronousTessellation = 1 << 2
     };
 
     Q_ENUM( Hint )
@@ -25,9 +25,10 @@ class QskFillNodePrivate : public QSGGeometryNodePrivate
     {
     }
 
-  private:
+  protected:
     friend class QskFillNode;
 
+    // the geometry of the node, unless being shared with other nodes
     QSGGeometry geometry;
 
     uint coloring : 5;
@@ -700,6 +700,12 @@ QskGradientMaterial::QskGradientMaterial( QskGradient::Type type )
 {
 }
 
+QskGradientMaterial::~QskGradientMaterial()
+{
+    if ( !m_stops.isEmpty() )
+        QskColorRamp::deref( m_stops, m_spreadMode );
+}
+
 template< typename Material >
 inline Material* qskEnsureMaterial( QskGradientMaterial* material )
 {
@@ -721,8 +727,24 @@ bool QskGradientMaterial::updateGradient( const QRectF& rect, const QskGradient&
             case QskGradient::Radial:
             case QskGradient::Conic:
             {
+                const auto stops = m_stops;
+                const auto spreadMode = m_spreadMode;
+
                 auto material = static_cast< GradientMaterial* >( this );
-                return material->setGradient( gradient.stretchedTo( rect ) );
+                if ( !material->setGradient( gradient.stretchedTo( rect ) ) )
+                    return false;
+
+                if ( ( stops != m_stops ) || ( spreadMode != m_spreadMode ) )
+                {
+                    // the color ramp in use must not be evicted
+                    if ( !m_stops.isEmpty() )
+                        QskColorRamp::ref( m_stops, m_spreadMode );
+
+                    if ( !stops.isEmpty() )
+                        QskColorRamp::deref( stops, spreadMode );
+                }
+
+                return true;
             }
 
             default:
@@ -13,6 +13,8 @@
 class QSK_EXPORT QskGradientMaterial : public QSGMaterial
 {
   public:
+    ~QskGradientMaterial() override;
+
     static QskGradientMaterial* createMaterial( QskGradient::Type );
 
     bool updateGradient( const QRectF&, const QskGradient& );
@@ -20,6 +20,8 @@ namespace
 
 QskGraphicNode::QskGraphicNode()
 {
+    // f.e the same icon in all rows of a list
+    setTextureSharing( true );
 }
 
 QskGraphicNode::~QskGraphicNode()
@@ -56,6 +58,28 @@ void QskGraphicNode::paint( QPainter* painter, const QSize& size, const void* no
     graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
 }
 
+QskPaintedNode::PaintFunction QskGraphicNode::paintFunction( const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+
+    /*
+        QPixmap can't be used outside of the GUI thread. As rescaling raster data
+        is not expensive anyway we paint those graphics synchronously.
+     */
+    if ( graphicData->graphic.commandTypes() & QskGraphic::RasterData )
+        return PaintFunction();
+
+    // QskGraphic is implicitly shared
+    const auto graphic = graphicData->graphic;
+    const auto colorFilter = graphicData->colorFilter;
+
+    return [ graphic, colorFilter ]( QPainter* painter, const QSize& size )
+    {
+        const QRectF rect( 0, 0, size.width(), size.height() );
+        graphic.render( painter, rect, colorFilter, Qt::IgnoreAspectRatio );
+    };
+}
+
 QskHashValue QskGraphicNode::hash( const void* nodeData ) const
 {
     const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
@@ -73,3 +97,39 @@ QskHashValue QskGraphicNode::hash( const void* nodeData ) const
 
     return graphic.hash( hash );
 }
+
+QByteArray QskGraphicNode::identity( const void* nodeData ) const
+{
+    const auto graphicData = reinterpret_cast< const GraphicData* >( nodeData );
+
+    const auto& graphic = graphicData->graphic;
+    const auto& substitutions = graphicData->colorFilter.substitutions();
+
+    /*
+        The modification id is unique for the commands of a graphic, and
+        the color filter is identified by its substitutions.
+     */
+    const auto modificationId = graphic.modificationId();
+    const auto renderHints = static_cast< int >( graphic.renderHints() );
+    const auto viewBox = graphic.viewBox();
+
+    const auto substitutionsSize = substitutions.size() * sizeof( substitutions[ 0 ] );
+
+    QByteArray identity;
+    identity.reserve( sizeof( modificationId ) + sizeof( renderHints )
+        + sizeof( viewBox ) + substitutionsSize );
+
+    identity.append( reinterpret_cast< const char* >( &modificationId ),
+        sizeof( modificationId ) );
+    identity.append( reinterpret_cast< const char* >( &renderHints ),
+        sizeof( renderHints ) );
+    identity.append( reinterpret_cast< const char* >( &viewBox ), sizeof( viewBox ) );
+
+    if ( substitutionsSize > 0 )
+    {
+        identity.append( reinterpret_cast< const char* >( substitutions.constData() ),
+            substitutionsSize );
+    }
+
+    return identity;
+}
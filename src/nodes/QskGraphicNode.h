@@ -23,6 +23,8 @@ class QSK_EXPORT QskGraphicNode : public QskPaintedNode
   private:
     virtual void paint( QPainter*, const QSize&, const void* nodeData ) override;
     virtual QskHashValue hash( const void* nodeData ) const override;
+    virtual QByteArray identity( const void* nodeData ) const override;
+    virtual PaintFunction paintFunction( const void* nodeData ) const override;
 };
 
 #endif
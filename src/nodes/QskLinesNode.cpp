@@ -86,25 +86,11 @@ static QSGGeometry::Point2D* qskAddLines( const QTransform& transform,
     if ( count <= 0 )
         return points;
 
-    const bool doTransform = !transform.isIdentity();
-
-    auto vlines = reinterpret_cast< QskVertex::Line* >( points );
-
-    for ( int i = 0; i < count; i++ )
-    {
-        auto p1 = lines[i].p1();
-        auto p2 = lines[i].p2();
-
-        if ( doTransform )
-        {
-            p1 = transform.map( p1 );
-            p2 = transform.map( p2 );
-        }
-
-        vlines++->setLine( p1.x(), p1.y(), p2.x(), p2.y() );
-    }
+    // QLineF is a pair of QPointF: x1, y1, x2, y2
+    const auto xy = reinterpret_cast< const qreal* >( lines );
+    QskVertex::fillPoints( transform, 2 * count, xy, points );
 
-    return reinterpret_cast< QSGGeometry::Point2D* >( vlines );
+    return points + 2 * count;
 }
 
 QskLinesNode::QskLinesNode()
@@ -6,6 +6,8 @@
 #include "QskPaintedNode.h"
 #include "QskSGNode.h"
 #include "QskTextureRenderer.h"
+#include "QskTextureCache.h"
+#include "QskTextureAtlas.h"
 #include "QskInternalMacros.h"
 #include "QskQuick.h"
 
@@ -13,6 +15,11 @@
 #include <qquickwindow.h>
 #include <qimage.h>
 #include <qpainter.h>
+#include <qatomic.h>
+#include <qcoreapplication.h>
+#include <qelapsedtimer.h>
+#include <qpointer.h>
+#include <qthreadpool.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qsgplaintexture_p.h>
@@ -43,14 +50,94 @@ namespace
 
         return static_cast< QSGImageNode* >( node );
     }
+
+    inline void releaseSharedTexture( QSGImageNode* imageNode )
+    {
+        if ( !imageNode->ownsTexture() )
+        {
+            if ( auto texture = imageNode->texture() )
+                QskTextureCache::release( texture );
+        }
+    }
+
+    void replaceTexture( QSGImageNode* imageNode, QSGTexture* texture, bool isShared )
+    {
+        auto oldTexture = imageNode->texture();
+        const bool ownsOldTexture = imageNode->ownsTexture();
+
+        // an owned texture gets deleted
+        imageNode->setTexture( texture );
+        imageNode->setOwnsTexture( !isShared );
+
+        if ( oldTexture && !ownsOldTexture )
+            QskTextureCache::release( oldTexture );
+    }
+
+    class PaintJobCounters
+    {
+      public:
+        QAtomicInt pendingCount;
+        QAtomicInteger< quint32 > lateCount;
+        QAtomicInteger< qint64 > lateTime;
+    };
+
+    PaintJobCounters paintJobCounters;
 }
 
+class QskPaintedNode::PaintJob
+{
+  public:
+    void run( const PaintFunction& paint )
+    {
+        QImage image( size, QImage::Format_RGBA8888_Premultiplied );
+        image.fill( Qt::transparent );
+
+        QPainter painter( &image );
+        painter.scale( devicePixelRatio, devicePixelRatio );
+
+        paint( &painter, size / devicePixelRatio );
+
+        painter.end();
+
+        this->image = image;
+        nsecs = timer.nsecsElapsed();
+
+        isFinished.storeRelease( 1 );
+        paintJobCounters.pendingCount.deref();
+
+        // the next frame will pick up the result: see QskPaintedNode::preprocess
+        const auto window = windowPointer;
+
+        QMetaObject::invokeMethod( QCoreApplication::instance(),
+            [ window ]() { if ( window ) window->update(); }, Qt::QueuedConnection );
+    }
+
+    QQuickWindow* window;
+    QPointer< QQuickWindow > windowPointer;
+
+    QskHashValue hash;
+    QByteArray identity;
+    QSize size;
+    qreal devicePixelRatio;
+
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    // a frame has been rendered without the result
+    bool isLate = false;
+
+    QAtomicInt isFinished;
+    QImage image;
+};
+
 QskPaintedNode::QskPaintedNode()
 {
 }
 
 QskPaintedNode::~QskPaintedNode()
 {
+    if ( auto imageNode = findImageNode( this ) )
+        releaseSharedTexture( imageNode );
 }
 
 void QskPaintedNode::setRenderHint( RenderHint renderHint )
@@ -82,6 +169,61 @@ Qt::Orientations QskPaintedNode::mirrored() const
     return m_mirrored;
 }
 
+void QskPaintedNode::setAsynchronous( bool on )
+{
+    // preprocess picks up the results of the paint jobs
+    setFlag( QSGNode::UsePreprocess, on );
+
+    if ( !on )
+        m_paintJob.reset();
+}
+
+bool QskPaintedNode::isAsynchronous() const
+{
+    return flags() & QSGNode::UsePreprocess;
+}
+
+int QskPaintedNode::pendingPaintJobs()
+{
+    return paintJobCounters.pendingCount.loadRelaxed();
+}
+
+quint32 QskPaintedNode::latePaintJobs()
+{
+    return paintJobCounters.lateCount.loadRelaxed();
+}
+
+qint64 QskPaintedNode::latePaintTime()
+{
+    return paintJobCounters.lateTime.loadRelaxed();
+}
+
+void QskPaintedNode::resetPaintJobCounters()
+{
+    paintJobCounters.lateCount.storeRelaxed( 0 );
+    paintJobCounters.lateTime.storeRelaxed( 0 );
+}
+
+QskPaintedNode::PaintFunction QskPaintedNode::paintFunction( const void* ) const
+{
+    return PaintFunction();
+}
+
+QByteArray QskPaintedNode::identity( const void* ) const
+{
+    return QByteArray();
+}
+
+void QskPaintedNode::setTextureSharing( bool on )
+{
+    m_textureSharing = on;
+}
+
+bool QskPaintedNode::textureSharing() const
+{
+    return m_textureSharing;
+}
+
 QSize QskPaintedNode::textureSize() const
 {
     if ( const auto imageNode = findImageNode( this ) )
@@ -106,8 +248,12 @@ void QskPaintedNode::update( QQuickWindow* window,
 
     if ( rect.isEmpty() )
     {
+        m_paintJob.reset();
+
         if ( imageNode )
         {
+            releaseSharedTexture( imageNode );
+
             removeChildNode( imageNode );
             delete imageNode;
         }
@@ -137,9 +283,13 @@ void QskPaintedNode::update( QQuickWindow* window,
     bool isTextureDirty = false;
 
     const auto newHash = hash( nodeData );
-    if ( ( newHash == 0 ) || ( newHash != m_hash ) )
+    const auto newIdentity = m_textureSharing ? identity( nodeData ) : QByteArray();
+
+    if ( ( newHash == 0 ) || ( newHash != m_hash ) || ( newIdentity != m_identity ) )
     {
         m_hash = newHash;
+        m_identity = newIdentity;
+
         isTextureDirty = true;
     }
     else
@@ -147,20 +297,140 @@ void QskPaintedNode::update( QQuickWindow* window,
         isTextureDirty = ( imageSize != textureSize() );
     }
 
-
     if ( isTextureDirty )
-        updateTexture( window, imageSize, nodeData );
+    {
+        if ( isAsynchronous()
+            && updateTextureAsynchronously( window, imageSize, nodeData ) )
+        {
+            // the current texture stays until the paint job has been finished
+        }
+        else
+        {
+            m_paintJob.reset();
+
+            if ( m_textureSharing && ( m_hash != 0 ) && !m_identity.isEmpty() )
+                updateSharedTexture( window, imageSize, nodeData );
+            else
+                updateTexture( window, imageSize, nodeData );
+        }
+    }
 
     imageNode->setRect( rect );
     imageNode->setTextureCoordinatesTransform(
         qskEffectiveTransformMode( m_mirrored ) );
 }
 
+bool QskPaintedNode::updateTextureAsynchronously(
+    QQuickWindow* window, const QSize& size, const void* nodeData )
+{
+    auto imageNode = findImageNode( this );
+
+    // without a texture we would have nothing to show meanwhile
+    if ( imageNode->texture() == nullptr || m_hash == 0 )
+        return false;
+
+    const auto ratio = window->effectiveDevicePixelRatio();
+
+    if ( m_textureSharing && !m_identity.isEmpty() )
+    {
+        // a texture from the cache is better than anything else
+        const QskTextureCache::Key key { window, m_hash, m_identity,
+            size, ratio, m_renderHint };
+        if ( QskTextureCache::contains( key ) )
+            return false;
+    }
+
+    if ( m_paintJob && m_paintJob->hash == m_hash
+        && m_paintJob->identity == m_identity && m_paintJob->size == size )
+    {
+        return true; // the same job is already running
+    }
+
+    const auto paint = paintFunction( nodeData );
+    if ( !paint )
+        return false;
+
+    QSharedPointer< PaintJob > job( new PaintJob() );
+
+    job->window = window;
+    job->windowPointer = window;
+    job->hash = m_hash;
+    job->identity = m_identity;
+    job->size = size;
+    job->devicePixelRatio = ratio;
+    job->timer.start();
+
+    // the result of a previous job will be ignored
+    m_paintJob = job;
+
+    paintJobCounters.pendingCount.ref();
+    QThreadPool::globalInstance()->start( [ job, paint ]() { job->run( paint ); } );
+
+    return true;
+}
+
+void QskPaintedNode::preprocess()
+{
+    if ( m_paintJob.isNull() )
+        return;
+
+    if ( !m_paintJob->isFinished.loadAcquire() )
+    {
+        m_paintJob->isLate = true;
+        return;
+    }
+
+    const auto job = m_paintJob;
+    m_paintJob.reset();
+
+    if ( job->isLate )
+    {
+        paintJobCounters.lateCount.ref();
+        paintJobCounters.lateTime.fetchAndAddRelaxed( job->nsecs );
+    }
+
+    auto imageNode = findImageNode( this );
+    if ( imageNode == nullptr )
+        return;
+
+    if ( m_textureSharing && !job->identity.isEmpty() )
+    {
+        const QskTextureCache::Key key { job->window, job->hash, job->identity,
+            job->size, job->devicePixelRatio, m_renderHint };
+
+        auto texture = QskTextureCache::acquire( key );
+        if ( texture == nullptr )
+        {
+            texture = QskTextureAtlas::createTexture( job->window, job->image );
+            QskTextureCache::insert( key, texture );
+        }
+
+        replaceTexture( imageNode, texture, true );
+    }
+    else
+    {
+        auto texture = QskTextureAtlas::createTexture( job->window, job->image );
+        replaceTexture( imageNode, texture, false );
+    }
+}
+
 void QskPaintedNode::updateTexture( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
     auto imageNode = findImageNode( this );
 
+    if ( !imageNode->ownsTexture() || QskTextureAtlas::isAtlasSize( size ) )
+    {
+        /*
+            A texture, that is shared with other nodes, must not be modified
+            and textures from the atlas can't be resized. So we always
+            need a new one.
+         */
+
+        replaceTexture( imageNode, createTexture( window, size, nodeData ), false );
+        return;
+    }
+
     if ( ( m_renderHint == OpenGL ) && qskIsOpenGLWindow( window ) )
     {
         const auto textureId = createTextureGL( window, size, nodeData );
@@ -188,6 +458,50 @@ void QskPaintedNode::updateTexture( QQuickWindow* window,
     }
 }
 
+void QskPaintedNode::updateSharedTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    auto imageNode = findImageNode( this );
+
+    const QskTextureCache::Key key { window, m_hash, m_identity, size,
+        window->effectiveDevicePixelRatio(), m_renderHint };
+
+    auto texture = QskTextureCache::acquire( key );
+    if ( texture == nullptr )
+    {
+        texture = createTexture( window, size, nodeData );
+        QskTextureCache::insert( key, texture );
+    }
+
+    replaceTexture( imageNode, texture, true );
+}
+
+QSGTexture* QskPaintedNode::createTexture( QQuickWindow* window,
+    const QSize& size, const void* nodeData )
+{
+    if ( QskTextureAtlas::isAtlasSize( size ) )
+    {
+        // rendering small images into FBOs does not pay off
+        const auto image = createImage( window, size, nodeData );
+        return QskTextureAtlas::createTexture( window, image );
+    }
+
+    if ( ( m_renderHint == OpenGL ) && qskIsOpenGLWindow( window ) )
+    {
+        const auto textureId = createTextureGL( window, size, nodeData );
+
+        auto texture = new QSGPlainTexture;
+        texture->setHasAlphaChannel( true );
+        texture->setOwnsTexture( true );
+
+        QskTextureRenderer::setTextureId( window, textureId, size, texture );
+
+        return texture;
+    }
+
+    return window->createTextureFromImage( createImage( window, size, nodeData ) );
+}
+
 QImage QskPaintedNode::createImage( QQuickWindow* window,
     const QSize& size, const void* nodeData )
 {
@@ -7,11 +7,16 @@
 #define QSK_PAINTED_NODE_H
 
 #include "QskGlobal.h"
+#include <qbytearray.h>
 #include <qsgnode.h>
+#include <qsharedpointer.h>
+
+#include <functional>
 
 class QQuickWindow;
 class QPainter;
 class QImage;
+class QSGTexture;
 
 class QSK_EXPORT QskPaintedNode : public QSGNode
 {
@@ -26,6 +31,9 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
 
         OpenGL might be ignored depending on the backend used by the
         application.
+
+        Small images are always painted by the raster paint engine and
+        uploaded into the texture atlas of the scene graph: see QskTextureAtlas.
      */
     enum RenderHint : quint8
     {
@@ -42,26 +50,76 @@ class QSK_EXPORT QskPaintedNode : public QSGNode
     void setMirrored( Qt::Orientations );
     Qt::Orientations mirrored() const;
 
+    /*
+        Nodes with the same hash value and identity might share their textures,
+        instead of painting the same content again: see QskTextureCache.
+     */
+    void setTextureSharing( bool );
+    bool textureSharing() const;
+
+    /*
+        Painting the content in a worker thread, while the current texture
+        stays visible until the new one is available. Only supported,
+        when the node offers a paintFunction().
+     */
+    void setAsynchronous( bool );
+    bool isAsynchronous() const;
+
+    // counters of the asynchronous paint jobs of all nodes
+    static int pendingPaintJobs();
+
+    // number/time ( in ns ) of jobs, that had not been finished for the next frame
+    static quint32 latePaintJobs();
+    static qint64 latePaintTime();
+
+    static void resetPaintJobCounters();
+
     QRectF rect() const;
     QSize textureSize() const;
 
     virtual void paint( QPainter*, const QSize&, const void* nodeData ) = 0;
 
+    void preprocess() override;
+
   protected:
     void update( QQuickWindow*, const QRectF&, const QSizeF&, const void* nodeData );
 
     // a hash value of '0' always results in repainting
     virtual QskHashValue hash( const void* nodeData ) const = 0;
 
+    /*
+        Something that identifies the content, when sharing textures.
+        An empty identity - the default - disables sharing.
+     */
+    virtual QByteArray identity( const void* nodeData ) const;
+
+    /*
+        A function with copies of everything that is needed to paint
+        the content in a worker thread. An invalid function indicates,
+        that the content needs to be painted synchronously.
+     */
+    using PaintFunction = std::function< void( QPainter*, const QSize& ) >;
+    virtual PaintFunction paintFunction( const void* nodeData ) const;
+
   private:
+    class PaintJob;
+
+    bool updateTextureAsynchronously( QQuickWindow*, const QSize&, const void* nodeData );
     void updateTexture( QQuickWindow*, const QSize&, const void* nodeData );
+    void updateSharedTexture( QQuickWindow*, const QSize&, const void* nodeData );
+
+    QSGTexture* createTexture( QQuickWindow*, const QSize&, const void* nodeData );
 
     QImage createImage( QQuickWindow*, const QSize&, const void* nodeData );
     quint32 createTextureGL( QQuickWindow*, const QSize&, const void* nodeData );
 
     RenderHint m_renderHint = OpenGL;
     Qt::Orientations m_mirrored;
+    bool m_textureSharing = false;
     QskHashValue m_hash = 0;
+    QByteArray m_identity;
+
+    QSharedPointer< PaintJob > m_paintJob;
 };
 
 #endif
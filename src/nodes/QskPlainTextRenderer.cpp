@@ -8,14 +8,21 @@
 #include "QskTextOptions.h"
 #include "QskInternalMacros.h"
 
+#include <qcache.h>
 #include <qfontmetrics.h>
+#include <qglobalstatic.h>
+#include <qglyphrun.h>
 #include <qmath.h>
+#include <qmutex.h>
+#include <qsharedpointer.h>
 #include <qsgnode.h>
 
 QSK_QT_PRIVATE_BEGIN
 #include <private/qquickitem_p.h>
 QSK_QT_PRIVATE_END
 
+#include <limits>
+
 #define GlyphFlag static_cast< QSGNode::Flag >( 0x800 )
 
 static void qskSetupLayout( QTextLayout& layout, const QString& text, const QFont& font,
@@ -94,27 +101,290 @@ static void qskSetupLayout( QTextLayout& layout, const QString& text, const QFon
     layout.endLayout();
 }
 
+static inline bool qskHasTrailingSpace( const QString& text )
+{
+    for ( int i = 1; i <= text.size(); i++ )
+    {
+        if ( i == text.size() || text[i] == QLatin1Char( '\n' ) )
+        {
+            if ( text[i - 1].isSpace() )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+static inline Qt::Alignment qskVisualAlignment(
+    Qt::Alignment alignment, bool isRightToLeft )
+{
+    // see QGuiApplicationPrivate::visualAlignment
+
+    if ( !( alignment & Qt::AlignHorizontal_Mask ) )
+        alignment |= Qt::AlignLeft;
+
+    if ( !( alignment & Qt::AlignAbsolute )
+        && ( alignment & ( Qt::AlignLeft | Qt::AlignRight ) ) )
+    {
+        if ( isRightToLeft )
+            alignment ^= ( Qt::AlignLeft | Qt::AlignRight );
+    }
+
+    return alignment;
+}
+
+namespace
+{
+    /*
+        The result of shaping a text: the glyph runs of each line for
+        a text, that is aligned to the left. The offsets for other
+        alignments can be applied when rendering, so that measuring
+        the text for the size hints and updating the node can share
+        the same shaping.
+     */
+    class ShapedText
+    {
+      public:
+        class Line
+        {
+          public:
+            QList< QGlyphRun > glyphRuns;
+            qreal naturalWidth;
+        };
+
+        QRectF boundingRect( qreal width ) const
+        {
+            if ( lines.isEmpty() )
+                return QRectF();
+
+            // see QTextLayout::boundingRect
+            constexpr qreal maxWidth = std::numeric_limits< int >::max() / 256.0;
+
+            const auto w = ( width < maxWidth ) ? qMax( width, textWidth ) : textWidth;
+            return QRectF( 0.0, top, w, height );
+        }
+
+        qreal alignmentOffset( const Line& line,
+            Qt::Alignment alignment, qreal width ) const
+        {
+            if ( isAligned )
+                return 0.0; // already done by QTextLayout
+
+            alignment = qskVisualAlignment( alignment, isRightToLeft );
+
+            if ( alignment & Qt::AlignRight )
+                return width - line.naturalWidth;
+
+            if ( alignment & Qt::AlignHCenter )
+                return 0.5 * ( width - line.naturalWidth );
+
+            return 0.0;
+        }
+
+        QVector< Line > lines;
+
+        qreal textWidth = 0.0;
+        qreal top = 0.0;
+        qreal height = 0.0;
+
+        bool isRightToLeft = false;
+
+        // the alignment has been applied by QTextLayout
+        bool isAligned = false;
+    };
+
+    class ShapeKey
+    {
+      public:
+        ShapeKey( const QString& text, const QFont& font,
+                const QskTextOptions& options, Qt::Alignment alignment, qreal width )
+            : text( text )
+            , font( font )
+            , options( options )
+            , width( width )
+        {
+            /*
+                Justified text and lines with trailing spaces can't be aligned
+                by simply moving the lines. We let QTextLayout do the job and
+                have to shape the text for each alignment then.
+             */
+            if ( ( alignment & Qt::AlignJustify ) || qskHasTrailingSpace( text ) )
+                this->alignment = alignment;
+
+            /*
+                Without wrapping and eliding the glyphs of a left aligned text do
+                not depend on the width and the text can be shaped once
+                for the size hints and the node.
+             */
+            if ( this->alignment == Qt::Alignment()
+                && options.wrapMode() == QskTextOptions::NoWrap
+                && options.effectiveElideMode() == Qt::ElideNone )
+            {
+                this->width = -1.0;
+            }
+
+            hash = qHash( text, 3119 );
+            hash = qHash( font, hash );
+            hash = options.hash( hash );
+            hash = qHash( static_cast< int >( this->alignment ), hash );
+            hash = qHash( this->width, hash );
+        }
+
+        bool operator==( const ShapeKey& other ) const noexcept
+        {
+            return ( hash == other.hash ) && ( width == other.width )
+                && ( alignment == other.alignment ) && ( options == other.options )
+                && ( text == other.text ) && ( font == other.font );
+        }
+
+        QString text;
+        QFont font;
+        QskTextOptions options;
+        Qt::Alignment alignment;
+        qreal width;
+
+        QskHashValue hash;
+    };
+
+    inline QskHashValue qHash( const ShapeKey& key, QskHashValue seed = 0 ) noexcept
+    {
+        return key.hash ^ seed;
+    }
+
+    /*
+        Measuring happens in the GUI thread, while updating the nodes
+        might happen in the scene graph thread. The entries are shared,
+        so that they can be used without locking the cache, even when
+        being evicted by another thread in the meantime.
+     */
+    using ShapedTextPtr = QSharedPointer< const ShapedText >;
+
+    class ShapeCache
+    {
+      public:
+        ShapeCache()
+        {
+            m_cache.setMaxCost( 1000 );
+        }
+
+        ShapedTextPtr find( const ShapeKey& key )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            if ( const auto entry = m_cache.object( key ) )
+                return *entry;
+
+            return ShapedTextPtr();
+        }
+
+        ShapedTextPtr insert( const ShapeKey& key, const ShapedTextPtr& shapedText )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            // another thread might have shaped the same text in the meantime
+            if ( const auto entry = m_cache.object( key ) )
+                return *entry;
+
+            m_cache.insert( key, new ShapedTextPtr( shapedText ) );
+            return shapedText;
+        }
+
+        void clear()
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.clear();
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< ShapeKey, ShapedTextPtr > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( ShapeCache, qskShapeCache )
+
+static ShapedText* qskShapeText( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width, bool isAligned )
+{
+    if ( !isAligned )
+        alignment = Qt::AlignLeft | Qt::AlignAbsolute;
+
+    QTextLayout layout;
+    qskSetupLayout( layout, text, font, options, alignment, width );
+
+    auto shapedText = new ShapedText();
+    shapedText->isRightToLeft = text.isRightToLeft();
+    shapedText->isAligned = isAligned;
+
+    const auto rect = layout.boundingRect();
+    shapedText->top = rect.top();
+    shapedText->height = rect.height();
+
+    shapedText->lines.reserve( layout.lineCount() );
+
+    for ( int i = 0; i < layout.lineCount(); i++ )
+    {
+        const auto line = layout.lineAt( i );
+
+        ShapedText::Line shapedLine;
+        shapedLine.glyphRuns = line.glyphRuns();
+        shapedLine.naturalWidth = line.naturalTextWidth();
+
+        shapedText->lines += shapedLine;
+        shapedText->textWidth = qMax( shapedText->textWidth, shapedLine.naturalWidth );
+    }
+
+    return shapedText;
+}
+
+template< typename Functor >
+static auto qskWithShapedText( const QString& text, const QFont& font,
+    const QskTextOptions& options, Qt::Alignment alignment, qreal width,
+    Functor functor )
+{
+    const ShapeKey key( text, font, options, alignment, width );
+
+    auto shapedText = qskShapeCache->find( key );
+    if ( shapedText.isNull() )
+    {
+        const ShapedTextPtr newText( qskShapeText( text, font, options,
+            key.alignment, width, key.alignment != Qt::Alignment() ) );
+
+        shapedText = qskShapeCache->insert( key, newText );
+    }
+
+    return functor( *shapedText );
+}
+
 QSizeF QskPlainTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
-    QTextLayout layout;
+    constexpr qreal width = 10e6;
 
-    qskSetupLayout( layout, text, font, options, Qt::Alignment(), 10e6 );
-    return layout.boundingRect().size();
+    return qskWithShapedText( text, font, options, Qt::Alignment(), width,
+        [ width ]( const ShapedText& shapedText )
+        { return shapedText.boundingRect( width ).size(); } );
 }
 
 QRectF QskPlainTextRenderer::textRect(
     const QString& text, const QFont& font, const QskTextOptions& options,
     Qt::Alignment alignment, const QSizeF& size )
 {
-    QTextLayout layout;
+    const auto width = size.width();
+
+    return qskWithShapedText( text, font, options, alignment, width,
+        [ width ]( const ShapedText& shapedText )
+        { return shapedText.boundingRect( width ); } );
+}
 
-    qskSetupLayout( layout, text, font, options, alignment, size.width() );
-    return layout.boundingRect();
+void QskPlainTextRenderer::clearCache()
+{
+    qskShapeCache->clear();
 }
 
 static void qskRenderText(
-    QQuickItem* item, QSGNode* parentNode, const QTextLayout& layout, qreal baseLine,
+    QQuickItem* item, QSGNode* parentNode, const ShapedText& shapedText,
+    Qt::Alignment alignment, qreal width, qreal baseLine,
     const QColor& color, QQuickText::TextStyle style, const QColor& styleColor )
 {
     auto renderContext = QQuickItemPrivate::get(item)->sceneGraphRenderContext();
@@ -135,13 +405,12 @@ static void qskRenderText(
 
     auto glyphNode = static_cast< QSGGlyphNode* >( parentNode->firstChild() );
 
-    const QPointF position( 0, baseLine );
-
-    for ( int i = 0; i < layout.lineCount(); ++i )
+    for ( const auto& line : shapedText.lines )
     {
-        const auto glyphRuns = layout.lineAt( i ).glyphRuns();
+        const QPointF position(
+            shapedText.alignmentOffset( line, alignment, width ), baseLine );
 
-        for ( const auto& glyphRun : glyphRuns )
+        for ( const auto& glyphRun : line.glyphRuns )
         {
             if ( glyphNode == nullptr )
             {
@@ -195,17 +464,9 @@ static void qskRenderText(
     }
 }
 
-void QskPlainTextRenderer::updateNode( const QString& text,
-    const QFont& font, const QskTextOptions& options,
-    Qsk::TextStyle style, const QskTextColors& colors,
-    Qt::Alignment alignment, const QRectF& rect,
-    const QQuickItem* item, QSGTransformNode* node )
+static qreal qskBaseLine( const QFont& font,
+    Qt::Alignment alignment, const QRectF& rect, qreal textHeight )
 {
-    QTextLayout layout;
-    qskSetupLayout( layout, text, font, options, alignment, rect.width() );
-
-    const qreal textHeight = layout.boundingRect().height();
-
     const qreal y0 = QFontMetricsF( font ).ascent();
 
     qreal yBaseline = y0;
@@ -231,10 +492,32 @@ void QskPlainTextRenderer::updateNode( const QString& text,
         yBaseline = ( bh % 2 ) ? qFloor( yBaseline ) : qCeil( yBaseline );
     }
 
-    qskRenderText(
-        const_cast< QQuickItem* >( item ), node, layout, yBaseline,
-        colors.textColor(), static_cast< QQuickText::TextStyle >( style ),
-        colors.styleColor() );
+    return yBaseline;
+}
+
+void QskPlainTextRenderer::updateNode( const QString& text,
+    const QFont& font, const QskTextOptions& options,
+    Qsk::TextStyle style, const QskTextColors& colors,
+    Qt::Alignment alignment, const QRectF& rect,
+    const QQuickItem* item, QSGTransformNode* node )
+{
+    const auto render = [ & ]( const ShapedText& shapedText )
+    {
+        const auto width = rect.width();
+        const qreal textHeight = shapedText.boundingRect( width ).height();
+
+        const qreal yBaseline = qskBaseLine( font, alignment, rect, textHeight );
+
+        qskRenderText( const_cast< QQuickItem* >( item ), node,
+            shapedText, alignment, width, yBaseline,
+            colors.textColor(), static_cast< QQuickText::TextStyle >( style ),
+            colors.styleColor() );
+
+        return true;
+    };
+
+    // the glyphs are usually available from measuring the text for the size hints
+    qskWithShapedText( text, font, options, alignment, rect.width(), render );
 }
 
 void QskPlainTextRenderer::updateNodeColor(
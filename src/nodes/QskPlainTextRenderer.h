@@ -37,6 +37,9 @@ namespace QskPlainTextRenderer
 
     QSK_EXPORT QRectF textRect( const QString&, const QFont&,
         const QskTextOptions&, Qt::Alignment, const QSizeF& );
+
+    // dropping the cached results of shaping texts
+    QSK_EXPORT void clearCache();
 }
 
 #endif
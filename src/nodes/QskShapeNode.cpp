@@ -8,6 +8,7 @@
 #include "QskGradientDirection.h"
 #include "QskVertex.h"
 #include "QskFillNodePrivate.h"
+#include "QskTessellationCache.h"
 #include "QskInternalMacros.h"
 
 QSK_QT_PRIVATE_BEGIN
@@ -25,11 +26,8 @@ static void qskUpdateGeometry( const QPainterPath& path,
 
     geometry.allocate( ts.vertices.size(), ts.indices.size() );
 
-    auto vertexData = reinterpret_cast< float* >( geometry.vertexData() );
-    const auto points = ts.vertices.constData();
-
-    for ( int i = 0; i < ts.vertices.count(); i++ )
-        vertexData[i] = points[i];
+    QskVertex::fillPoints( ts.vertices.count() / 2,
+        ts.vertices.constData(), geometry.vertexDataAsPoint2D() );
 
     memcpy( geometry.indexData(), ts.indices.data(),
         ts.indices.size() * sizeof( quint16 ) );
@@ -37,8 +35,8 @@ static void qskUpdateGeometry( const QPainterPath& path,
 
 #else
 
-static void qskUpdateGeometry( const QPainterPath& path,
-    const QTransform& transform, const QColor& color, QSGGeometry& geometry )
+static QVector< float > qskFillVertices(
+    const QPainterPath& path, const QTransform& transform )
 {
     const auto ts = qTriangulate( path, transform, 1, false );
 
@@ -60,27 +58,56 @@ static void qskUpdateGeometry( const QPainterPath& path,
     const auto points = ts.vertices.constData();
     const auto indices = reinterpret_cast< const quint16* >( ts.indices.data() );
 
-    geometry.allocate( ts.indices.size() );
+    QVector< float > vertices( 2 * ts.indices.size() );
 
-    if ( color.isValid() )
-    {
-        const QskVertex::Color c = color;
+    QskVertex::fillPoints( ts.indices.size(), indices, points,
+        reinterpret_cast< QSGGeometry::Point2D* >( vertices.data() ) );
+
+    return vertices;
+}
 
-        auto vertexData = geometry.vertexDataAsColoredPoint2D();
-        for ( int i = 0; i < ts.indices.size(); i++ )
+static bool qskFindVertices( const QPainterPath& path, const QTransform& transform,
+    bool async, bool isWaiting, QVector< float >& vertices )
+{
+    const QskTessellationCache::Key key( path, transform );
+
+    if ( !QskTessellationCache::find( key, vertices ) )
+    {
+        /*
+            When the node has been waiting, but the job is not pending anymore,
+            the result did not make it into the cache and we do it now.
+         */
+        if ( async && !( isWaiting && !QskTessellationCache::isPending( key ) ) )
         {
-            const int j = 2 * indices[i];
-            vertexData[i].set( points[j], points[j + 1], c.r, c.g, c.b, c.a );
+            QskTessellationCache::tessellate( key,
+                [ path, transform ]() { return qskFillVertices( path, transform ); },
+                QskTessellationCache::NodeRequest );
+
+            return false;
         }
+
+        vertices = qskFillVertices( path, transform );
+        QskTessellationCache::insert( key, vertices );
+    }
+
+    return true;
+}
+
+static void qskUpdateGeometry( const QVector< float >& vertices,
+    const QColor& color, QSGGeometry& geometry )
+{
+    const auto count = vertices.size() / 2;
+    geometry.allocate( count );
+
+    if ( color.isValid() )
+    {
+        QskVertex::fillPoints( count, vertices.constData(),
+            color, geometry.vertexDataAsColoredPoint2D() );
     }
     else
     {
-        auto vertexData = geometry.vertexDataAsPoint2D();
-        for ( int i = 0; i < ts.indices.size(); i++ )
-        {
-            const int j = 2 * indices[i];
-            vertexData[i].set( points[j], points[j + 1] );
-        }
+        memcpy( geometry.vertexData(), vertices.constData(),
+            vertices.size() * sizeof( float ) );
     }
 }
 
@@ -95,6 +122,12 @@ class QskShapeNodePrivate final : public QskFillNodePrivate
      */
     QPainterPath path;
     QTransform transform;
+
+    // the color of a colored geometry
+    QColor color;
+
+    // waiting for an asynchronous tessellation of path/transform
+    bool isWaiting = false;
 };
 
 QskShapeNode::QskShapeNode()
@@ -125,6 +158,9 @@ void QskShapeNode::updatePath( const QPainterPath& path,
     {
         d->path = QPainterPath();
         d->transform = QTransform();
+        d->color = QColor();
+        d->isWaiting = false;
+
         resetGeometry();
 
         return;
@@ -137,19 +173,80 @@ void QskShapeNode::updatePath( const QPainterPath& path,
 
     const bool isDirty = ( isGeometryColored() != c.isValid() );
 
+    const bool isModified = ( transform != d->transform ) || ( path != d->path );
+    const bool isWaiting = d->isWaiting && !isModified;
+
+    const bool doTessellate = isDirty || isModified || isWaiting;
+
+    QVector< float > vertices;
+
+    if ( doTessellate )
+    {
+        d->path = path;
+        d->transform = transform;
+
+        const bool async = hasHint( PreferAsynchronousTessellation );
+
+        if ( !qskFindVertices( path, transform, async, isWaiting, vertices ) )
+        {
+            /*
+                Keeping the previous geometry until the result is available.
+                As changing the coloring might also change the vertex
+                layout of the geometry, we don't touch it before.
+             */
+            d->isWaiting = true;
+            return;
+        }
+    }
+
     if ( c.isValid() )
         setColoring( QskFillNode::Polychrome );
     else
         setColoring( rect, gradient );
 
-    if ( isDirty || ( transform != d->transform ) || ( path != d->path ) )
+    if ( doTessellate )
     {
-        d->path = path;
-        d->transform = transform;
+        qskUpdateGeometry( vertices, c, *geometry() );
+
+        d->color = c;
+        d->isWaiting = false;
+
+        geometry()->markVertexDataDirty();
+        markDirty( QSGNode::DirtyGeometry );
+    }
+    else if ( c.isValid() && ( c != d->color ) )
+    {
+        // recoloring without tessellating again
 
-        qskUpdateGeometry( path, transform, c, *geometry() );
+        d->color = c;
+
+        const QskVertex::Color color( c );
+
+        auto points = geometry()->vertexDataAsColoredPoint2D();
+        for ( int i = 0; i < geometry()->vertexCount(); i++ )
+        {
+            auto& p = points[i];
+            p.set( p.x, p.y, color.r, color.g, color.b, color.a );
+        }
 
         geometry()->markVertexDataDirty();
         markDirty( QSGNode::DirtyGeometry );
     }
 }
+
+void QskShapeNode::prepareTessellation(
+    const QPainterPath& path, const QTransform& transform )
+{
+    if ( path.isEmpty() )
+        return;
+
+    const QskTessellationCache::Key key( path, transform );
+
+    QVector< float > vertices;
+    if ( !QskTessellationCache::find( key, vertices ) )
+    {
+        QskTessellationCache::tessellate( key,
+            [ path, transform ]() { return qskFillVertices( path, transform ); },
+            QskTessellationCache::PrepareRequest );
+    }
+}
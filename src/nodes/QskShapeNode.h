@@ -26,6 +26,13 @@ class QSK_EXPORT QskShapeNode : public QskFillNode
     void updatePath( const QPainterPath&, const QTransform&,
         const QRectF&, const QskGradient& );
 
+    /*
+        Starting the tessellation in a worker thread in advance - f.e from
+        the GUI thread, when the path has been changed. Then the result might
+        be available, when updating a node with the same path/transform.
+     */
+    static void prepareTessellation( const QPainterPath&, const QTransform& );
+
   private:
     Q_DECLARE_PRIVATE( QskShapeNode )
 };
@@ -7,6 +7,8 @@
 #include "QskVertex.h"
 #include "QskGradient.h"
 #include "QskRgbValue.h"
+#include "QskTessellationCache.h"
+#include "QskFillNodePrivate.h"
 #include "QskInternalMacros.h"
 
 #include <qpainterpath.h>
@@ -33,7 +35,110 @@ static inline bool qskIsPenVisible( const QPen& pen )
     return true;
 }
 
+static QVector< float > qskStrokeVertices(
+    const QPainterPath& path, const QTransform& transform, const QPen& pen )
+{
+    /*
+        Unfortunately QTriangulatingStroker does not offer on the fly
+        transformations - like with qTriangulate. TODO ...
+     */
+    const auto scaledPath = transform.map( path );
+
+    auto effectivePen = pen;
+
+    if ( !effectivePen.isCosmetic() )
+    {
+        const auto scaleFactor = qMin( transform.m11(), transform.m22() );
+        if ( scaleFactor != 1.0 )
+        {
+            effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
+            effectivePen.setCosmetic( false );
+        }
+    }
+
+    QTriangulatingStroker stroker;
+
+    if ( pen.style() == Qt::SolidLine )
+    {
+        // clipRect, renderHint are ignored in QTriangulatingStroker::process
+        stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+    }
+    else
+    {
+        constexpr QRectF clipRect; // empty rect: no clipping
+
+        QDashedStrokeProcessor dashStroker;
+        dashStroker.process( qtVectorPathForPath( scaledPath ),
+            effectivePen, clipRect, {} );
+
+        const QVectorPath dashedVectorPath( dashStroker.points(),
+            dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+
+        stroker.process( dashedVectorPath, effectivePen, {}, {} );
+    }
+
+    const auto v = stroker.vertices();
+    return QVector< float >( v, v + stroker.vertexCount() );
+}
+
+class QskStrokeNodePrivate final : public QskFillNodePrivate
+{
+  public:
+    inline bool updateStroke( const QPainterPath& path,
+        const QTransform& transform, const QPen& pen )
+    {
+        /*
+            Is there a better way to find out if the path has changed
+            beside storing a copy ( even, when internally with Copy On Write ) ?
+         */
+        const bool isDirty = ( path != this->path )
+            || ( transform != this->transform ) || !isSameStroke( pen );
+
+        if ( isDirty )
+        {
+            this->path = path;
+            this->transform = transform;
+            this->pen = pen;
+        }
+
+        return isDirty;
+    }
+
+    inline void reset()
+    {
+        path = QPainterPath();
+        transform = QTransform();
+        pen = QPen();
+
+        isWaiting = false;
+    }
+
+  private:
+    inline bool isSameStroke( const QPen& other ) const
+    {
+        // the color has no effect on the geometry
+
+        return ( pen.widthF() == other.widthF() )
+            && ( pen.style() == other.style() )
+            && ( pen.capStyle() == other.capStyle() )
+            && ( pen.joinStyle() == other.joinStyle() )
+            && ( pen.miterLimit() == other.miterLimit() )
+            && ( pen.isCosmetic() == other.isCosmetic() )
+            && ( pen.dashOffset() == other.dashOffset() )
+            && ( pen.dashPattern() == other.dashPattern() );
+    }
+
+  public:
+    QPainterPath path;
+    QTransform transform;
+    QPen pen;
+
+    // waiting for an asynchronous tessellation of path/transform/pen
+    bool isWaiting = false;
+};
+
 QskStrokeNode::QskStrokeNode()
+    : QskFillNode( *new QskStrokeNodePrivate )
 {
 }
 
@@ -47,91 +152,114 @@ void QskStrokeNode::updatePath( const QPainterPath& path, const QPen& pen )
 void QskStrokeNode::updatePath(
     const QPainterPath& path, const QTransform& transform, const QPen& pen )
 {
+    Q_D( QskStrokeNode );
+
     if ( path.isEmpty() || !qskIsPenVisible( pen ) )
     {
+        d->reset();
         resetGeometry();
+
         return;
     }
 
-    if ( auto qGradient = pen.brush().gradient() )
-    {
-        const auto r = transform.mapRect( path.boundingRect() );
+    /*
+        Strokes are always colored by the material. So the vertex layout
+        has to be changed, when the geometry is still colored from
+        the initial setting.
+     */
+    const bool isDirty = isGeometryColored();
 
-        QskGradient gradient( *qGradient );
-        gradient.setStretchMode( QskGradient::StretchToSize );
+    const bool isModified = d->updateStroke( path, transform, pen );
+    const bool isWaiting = d->isWaiting && !isModified;
 
-        setColoring( r, gradient );
-    }
-    else
-        setColoring( pen.color() );
+    const bool doTessellate = isDirty || isModified || isWaiting;
 
-    if ( true ) // For the moment we always update the geometry. TODO ...
-    {
-        /*
-            Unfortunately QTriangulatingStroker does not offer on the fly
-            transformations - like with qTriangulate. TODO ...
-         */
-        const auto scaledPath = transform.map( path );
+    QVector< float > vertices;
 
-        auto effectivePen = pen;
+    if ( doTessellate )
+    {
+        const QskTessellationCache::Key key( path, transform, pen );
 
-        if ( !effectivePen.isCosmetic() )
+        if ( !QskTessellationCache::find( key, vertices ) )
         {
-            const auto scaleFactor = qMin( transform.m11(), transform.m22() );
-            if ( scaleFactor != 1.0 )
+            /*
+                When the node has been waiting, but the job is not pending anymore,
+                the result did not make it into the cache and we do it now.
+             */
+            const bool async = hasHint( PreferAsynchronousTessellation )
+                && !( isWaiting && !QskTessellationCache::isPending( key ) );
+
+            if ( async )
             {
-                effectivePen.setWidth( effectivePen.widthF() * scaleFactor );
-                effectivePen.setCosmetic( false );
-            }
-        }
+                QskTessellationCache::tessellate( key,
+                    [ path, transform, pen ]()
+                    { return qskStrokeVertices( path, transform, pen ); },
+                    QskTessellationCache::NodeRequest );
 
-        QTriangulatingStroker stroker;
+                /*
+                    Keeping the previous geometry and coloring until
+                    the result is available.
+                 */
+                d->isWaiting = true;
+                return;
+            }
 
-        if ( pen.style() == Qt::SolidLine )
-        {
-            // clipRect, renderHint are ignored in QTriangulatingStroker::process
-            stroker.process( qtVectorPathForPath( scaledPath ), effectivePen, {}, {} );
+            vertices = qskStrokeVertices( path, transform, pen );
+            QskTessellationCache::insert( key, vertices );
         }
-        else
-        {
-            constexpr QRectF clipRect; // empty rect: no clipping
+    }
+
+    if ( auto qGradient = pen.brush().gradient() )
+    {
+        const auto r = transform.mapRect( path.boundingRect() );
 
-            QDashedStrokeProcessor dashStroker;
-            dashStroker.process( qtVectorPathForPath( scaledPath ),
-                effectivePen, clipRect, {} );
+        QskGradient gradient( *qGradient );
+        gradient.setStretchMode( QskGradient::StretchToSize );
 
-            const QVectorPath dashedVectorPath( dashStroker.points(),
-                dashStroker.elementCount(), dashStroker.elementTypes(), 0 );
+        setColoring( r, gradient );
+    }
+    else
+        setColoring( pen.color() );
 
-            stroker.process( dashedVectorPath, effectivePen, {}, {} );
-        }
+    if ( doTessellate )
+    {
+        d->isWaiting = false;
 
         auto& geometry = *this->geometry();
 
         // 2 vertices for each point
         geometry.setDrawingMode( QSGGeometry::DrawTriangleStrip );
-        geometry.allocate( stroker.vertexCount() / 2 );
+        geometry.allocate( vertices.size() / 2 );
 
         if ( isGeometryColored() )
         {
-            const QskVertex::Color c( pen.color() );
-
-            const auto v = stroker.vertices();
-            auto points = geometry.vertexDataAsColoredPoint2D();
-
-            for ( int i = 0; i < geometry.vertexCount(); i++ )
-            {
-                const auto j = 2 * i;
-                points[i].set( v[j], v[j + 1], c.r, c.g, c.b, c.a );
-            }
+            QskVertex::fillPoints( geometry.vertexCount(), vertices.constData(),
+                pen.color(), geometry.vertexDataAsColoredPoint2D() );
         }
         else
         {
-            memcpy( geometry.vertexData(), stroker.vertices(),
-                stroker.vertexCount() * sizeof( float ) );
+            memcpy( geometry.vertexData(), vertices.constData(),
+                vertices.size() * sizeof( float ) );
         }
 
         geometry.markVertexDataDirty();
         markDirty( QSGNode::DirtyGeometry );
     }
 }
+
+void QskStrokeNode::prepareTessellation( const QPainterPath& path,
+    const QTransform& transform, const QPen& pen )
+{
+    if ( path.isEmpty() || !qskIsPenVisible( pen ) )
+        return;
+
+    const QskTessellationCache::Key key( path, transform, pen );
+
+    QVector< float > vertices;
+    if ( !QskTessellationCache::find( key, vertices ) )
+    {
+        QskTessellationCache::tessellate( key,
+            [ path, transform, pen ]() { return qskStrokeVertices( path, transform, pen ); },
+            QskTessellationCache::PrepareRequest );
+    }
+}
@@ -0,0 +1,337 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTessellationCache.h"
+#include "QskTessellationMonitor.h"
+
+#include <qcache.h>
+#include <qelapsedtimer.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qthreadpool.h>
+
+static inline QPen qskGeometryPen( const QPen& pen )
+{
+    // only the attributes, that have an effect on the geometry
+
+    if ( pen.style() == Qt::NoPen )
+        return QPen( Qt::NoPen );
+
+    QPen p( Qt::black, pen.widthF(), pen.style(), pen.capStyle(), pen.joinStyle() );
+    p.setMiterLimit( pen.miterLimit() );
+    p.setCosmetic( pen.isCosmetic() );
+
+    if ( pen.style() != Qt::SolidLine )
+    {
+        if ( pen.style() == Qt::CustomDashLine )
+            p.setDashPattern( pen.dashPattern() );
+
+        p.setDashOffset( pen.dashOffset() );
+    }
+
+    return p;
+}
+
+static inline QskHashValue qskHashPath(
+    const QPainterPath& path, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( path.fillRule() ), seed );
+
+    for ( int i = 0; i < path.elementCount(); i++ )
+    {
+        const auto e = path.elementAt( i );
+
+        hash = qHash( e.x, hash );
+        hash = qHash( e.y, hash );
+        hash = qHash( static_cast< int >( e.type ), hash );
+    }
+
+    return hash;
+}
+
+static inline QskHashValue qskHashPen( const QPen& pen, QskHashValue seed )
+{
+    auto hash = qHash( static_cast< int >( pen.style() ), seed );
+
+    if ( pen.style() != Qt::NoPen )
+    {
+        hash = qHash( pen.widthF(), hash );
+        hash = qHash( static_cast< int >( pen.capStyle() ), hash );
+        hash = qHash( static_cast< int >( pen.joinStyle() ), hash );
+        hash = qHash( pen.miterLimit(), hash );
+        hash = qHash( pen.isCosmetic(), hash );
+        hash = qHash( pen.dashOffset(), hash );
+
+        if ( pen.style() == Qt::CustomDashLine )
+        {
+            const auto pattern = pen.dashPattern();
+            hash = qHashRange( pattern.constBegin(), pattern.constEnd(), hash );
+        }
+    }
+
+    return hash;
+}
+
+QskTessellationCache::Key::Key( const QPainterPath& path,
+        const QTransform& transform, const QPen& pen )
+    : m_path( path )
+    , m_transform( transform )
+    , m_pen( qskGeometryPen( pen ) )
+{
+    m_hash = qskHashPath( path, 7937 );
+    m_hash = qHash( transform, m_hash );
+    m_hash = qskHashPen( m_pen, m_hash );
+}
+
+bool QskTessellationCache::Key::operator==( const Key& other ) const noexcept
+{
+    return ( m_hash == other.m_hash ) && ( m_transform == other.m_transform )
+        && ( m_pen == other.m_pen ) && ( m_path == other.m_path );
+}
+
+namespace
+{
+    class Cache
+    {
+      public:
+        Cache()
+        {
+            // 4 MB
+            m_cache.setMaxCost( 1024 * 1024 );
+        }
+
+        bool find( const QskTessellationCache::Key& key, QVector< float >& vertices )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            if ( const auto entry = m_cache.object( key ) )
+            {
+                vertices = *entry; // implicitly shared
+                return true;
+            }
+
+            return false;
+        }
+
+        void insert( const QskTessellationCache::Key& key,
+            const QVector< float >& vertices )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            // entries exceeding the capacity are not inserted by QCache
+            m_cache.insert( key, new QVector< float >( vertices ),
+                qMax( 1, static_cast< int >( vertices.size() ) ) );
+        }
+
+        void setCapacity( int capacity )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.setMaxCost( qMax( capacity, 0 ) );
+        }
+
+        int capacity()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_cache.maxCost();
+        }
+
+        void clear()
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.clear();
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< QskTessellationCache::Key, QVector< float > > m_cache;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+static void qskFinishJob( const QskTessellationCache::Key&, const QVector< float >& );
+
+namespace
+{
+    class Jobs
+    {
+      public:
+        void start( const QskTessellationCache::Key& key,
+            const QskTessellationCache::Tessellator& tessellator,
+            QskTessellationCache::Request request )
+        {
+            const bool isWaiting = ( request == QskTessellationCache::NodeRequest );
+
+            const QMutexLocker locker( &m_mutex );
+
+            auto it = m_jobs.find( key );
+            if ( it != m_jobs.end() )
+            {
+                if ( isWaiting && !it->isWaiting )
+                {
+                    it->isWaiting = true;
+                    it->timer.start();
+                }
+
+                return;
+            }
+
+            Job job;
+            job.isWaiting = isWaiting;
+            if ( isWaiting )
+                job.timer.start();
+
+            m_jobs.insert( key, job );
+
+            /*
+                The job might outlive the global statics, when the application
+                terminates. So it must not capture this.
+             */
+            QThreadPool::globalInstance()->start(
+                [ key, tessellator ]() { qskFinishJob( key, tessellator() ); } );
+        }
+
+        bool isPending( const QskTessellationCache::Key& key )
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_jobs.contains( key );
+        }
+
+        int pendingCount()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_jobs.count();
+        }
+
+        quint32 lateCount()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_lateCount;
+        }
+
+        qint64 lateTime()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_lateTime;
+        }
+
+        void resetCounters()
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            m_lateCount = 0;
+            m_lateTime = 0;
+        }
+
+        bool finish( const QskTessellationCache::Key& key,
+            const QVector< float >& vertices )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            // inserting before removing the job: there is no gap for isPending
+            if ( auto cache = qskCache() )
+                cache->insert( key, vertices );
+
+            const auto job = m_jobs.take( key );
+            if ( job.isWaiting )
+            {
+                m_lateCount++;
+                m_lateTime += job.timer.nsecsElapsed();
+            }
+
+            return job.isWaiting;
+        }
+
+      private:
+        class Job
+        {
+          public:
+            QElapsedTimer timer;
+            bool isWaiting = false;
+        };
+
+        QMutex m_mutex;
+        QHash< QskTessellationCache::Key, Job > m_jobs;
+
+        quint32 m_lateCount = 0;
+        qint64 m_lateTime = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( Jobs, qskJobs )
+
+static void qskFinishJob( const QskTessellationCache::Key& key,
+    const QVector< float >& vertices )
+{
+    auto jobs = qskJobs();
+    if ( jobs == nullptr )
+        return; // application is terminating
+
+    const bool isLate = jobs->finish( key, vertices );
+
+    if ( isLate )
+    {
+        // a node has been waiting: see QskItem::PreferAsynchronousTessellation
+        if ( auto monitor = QskTessellationMonitor::instance() )
+            Q_EMIT monitor->tessellationFinished();
+    }
+}
+
+bool QskTessellationCache::find( const Key& key, QVector< float >& vertices )
+{
+    return qskCache->find( key, vertices );
+}
+
+void QskTessellationCache::insert( const Key& key, const QVector< float >& vertices )
+{
+    qskCache->insert( key, vertices );
+}
+
+void QskTessellationCache::setCapacity( int capacity )
+{
+    qskCache->setCapacity( capacity );
+}
+
+int QskTessellationCache::capacity()
+{
+    return qskCache->capacity();
+}
+
+void QskTessellationCache::clear()
+{
+    qskCache->clear();
+}
+
+void QskTessellationCache::tessellate(
+    const Key& key, const Tessellator& tessellator, Request request )
+{
+    qskJobs->start( key, tessellator, request );
+}
+
+bool QskTessellationCache::isPending( const Key& key )
+{
+    return qskJobs->isPending( key );
+}
+
+int QskTessellationCache::pendingCount()
+{
+    return qskJobs->pendingCount();
+}
+
+quint32 QskTessellationCache::lateCount()
+{
+    return qskJobs->lateCount();
+}
+
+qint64 QskTessellationCache::lateTime()
+{
+    return qskJobs->lateTime();
+}
+
+void QskTessellationCache::resetCounters()
+{
+    qskJobs->resetCounters();
+}
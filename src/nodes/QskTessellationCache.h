@@ -0,0 +1,86 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TESSELLATION_CACHE_H
+#define QSK_TESSELLATION_CACHE_H
+
+#include "QskGlobal.h"
+
+#include <qpainterpath.h>
+#include <qpen.h>
+#include <qtransform.h>
+#include <qvector.h>
+
+#include <functional>
+
+/*
+    A process wide LRU cache for the results of tessellating paths, so that
+    repeated symbols or outlines are tessellated only once. The vertices
+    are stored as x/y pairs - like QSGGeometry::Point2D.
+ */
+namespace QskTessellationCache
+{
+    class Key
+    {
+      public:
+        // the color of the pen is ignored
+        Key( const QPainterPath&, const QTransform&, const QPen& = Qt::NoPen );
+
+        bool operator==( const Key& ) const noexcept;
+        inline QskHashValue hash() const noexcept { return m_hash; }
+
+      private:
+        QPainterPath m_path;
+        QTransform m_transform;
+        QPen m_pen;
+
+        QskHashValue m_hash;
+    };
+
+    bool find( const Key&, QVector< float >& vertices );
+    void insert( const Key&, const QVector< float >& vertices );
+
+    // maximum number of floats being stored
+    void setCapacity( int );
+    int capacity();
+
+    void clear();
+
+    /*
+        Tessellating in a worker thread of QThreadPool::globalInstance().
+        The result is inserted into the cache and QskTessellationMonitor::
+        tessellationFinished is emitted, when the result is late - what
+        means, that a node has been waiting for it.
+
+        Nothing happens if the same tessellation is already pending.
+     */
+    using Tessellator = std::function< QVector< float >() >;
+
+    enum Request
+    {
+        // a node is waiting for the result: see QskFillNode::PreferAsynchronousTessellation
+        NodeRequest,
+
+        // the result is not needed yet
+        PrepareRequest
+    };
+
+    void tessellate( const Key&, const Tessellator&, Request );
+    bool isPending( const Key& );
+
+    int pendingCount();
+
+    quint32 lateCount();
+    qint64 lateTime();
+
+    void resetCounters();
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 ) noexcept
+    {
+        return key.hash() ^ seed;
+    }
+}
+
+#endif
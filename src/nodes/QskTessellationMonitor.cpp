@@ -0,0 +1,53 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTessellationMonitor.h"
+#include "QskTessellationCache.h"
+
+#include <qglobalstatic.h>
+
+namespace
+{
+    class TessellationMonitor final : public QskTessellationMonitor
+    {
+    };
+}
+
+Q_GLOBAL_STATIC( TessellationMonitor, qskGlobalTessellationMonitor )
+
+QskTessellationMonitor* QskTessellationMonitor::instance()
+{
+    return qskGlobalTessellationMonitor;
+}
+
+QskTessellationMonitor::QskTessellationMonitor()
+{
+}
+
+QskTessellationMonitor::~QskTessellationMonitor()
+{
+}
+
+int QskTessellationMonitor::pendingCount() const
+{
+    return QskTessellationCache::pendingCount();
+}
+
+quint32 QskTessellationMonitor::lateCount() const
+{
+    return QskTessellationCache::lateCount();
+}
+
+qint64 QskTessellationMonitor::lateTime() const
+{
+    return QskTessellationCache::lateTime();
+}
+
+void QskTessellationMonitor::resetCounters()
+{
+    QskTessellationCache::resetCounters();
+}
+
+#include "moc_QskTessellationMonitor.cpp"
@@ -0,0 +1,59 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TESSELLATION_MONITOR_H
+#define QSK_TESSELLATION_MONITOR_H
+
+#include "QskGlobal.h"
+#include <qobject.h>
+
+#if defined( qskTessellationMonitor )
+#undef qskTessellationMonitor
+#endif
+
+#define qskTessellationMonitor QskTessellationMonitor::instance()
+
+/*
+    Paths of QskShapeNode/QskStrokeNode with the PreferAsynchronousTessellation
+    hint are tessellated in worker threads. Until the result is available
+    the node keeps its previous geometry. Then the item has to be updated
+    again, so that the node can pick up the result. This is done for all
+    items with the QskItem::PreferAsynchronousTessellation flag.
+ */
+class QSK_EXPORT QskTessellationMonitor : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY( int pendingCount READ pendingCount )
+    Q_PROPERTY( quint32 lateCount READ lateCount )
+    Q_PROPERTY( qint64 lateTime READ lateTime )
+
+  public:
+    static QskTessellationMonitor* instance();
+
+    // number of tessellations running or waiting in the thread pool
+    int pendingCount() const;
+
+    // number of results, that have not been available, when being needed
+    quint32 lateCount() const;
+
+    // accumulated time ( in ns ), that nodes have been waiting for late results
+    qint64 lateTime() const;
+
+    void resetCounters();
+
+  Q_SIGNALS:
+    /*
+        A late result has been finished. The signal is emitted from
+        a worker thread, so connections to items are queued.
+     */
+    void tessellationFinished();
+
+  protected:
+    QskTessellationMonitor();
+    ~QskTessellationMonitor() override;
+};
+
+#endif
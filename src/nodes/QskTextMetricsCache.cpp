@@ -0,0 +1,155 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextMetricsCache.h"
+
+#include <qcache.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+
+QskTextMetricsCache::Key::Key( const QString& text,
+        const QFont& font, const QskTextOptions& options )
+    : Key( text, font, options, Qt::Alignment(), QSizeF() )
+{
+    m_isBounded = false;
+    m_hash = ::qHash( m_isBounded, m_hash );
+}
+
+QskTextMetricsCache::Key::Key( const QString& text, const QFont& font,
+        const QskTextOptions& options, Qt::Alignment alignment, const QSizeF& size )
+    : m_text( text )
+    , m_font( font )
+    , m_options( options )
+    , m_alignment( alignment )
+    , m_size( size )
+    , m_isBounded( true )
+{
+    m_hash = ::qHash( text, 4391 );
+    m_hash = ::qHash( font, m_hash );
+    m_hash = options.hash( m_hash );
+    m_hash = ::qHash( static_cast< int >( alignment ), m_hash );
+    m_hash = ::qHash( size.width(), m_hash );
+    m_hash = ::qHash( size.height(), m_hash );
+}
+
+bool QskTextMetricsCache::Key::operator==( const Key& other ) const noexcept
+{
+    return ( m_hash == other.m_hash ) && ( m_isBounded == other.m_isBounded )
+        && ( m_size == other.m_size )
+        && ( m_alignment == other.m_alignment ) && ( m_options == other.m_options )
+        && ( m_text == other.m_text ) && ( m_font == other.m_font );
+}
+
+namespace
+{
+    class Cache
+    {
+      public:
+        Cache()
+        {
+            m_cache.setMaxCost( 4000 );
+        }
+
+        bool find( const QskTextMetricsCache::Key& key, QRectF& rect )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            if ( const auto entry = m_cache.object( key ) )
+            {
+                rect = *entry;
+                m_statistics.hits++;
+
+                return true;
+            }
+
+            m_statistics.misses++;
+            return false;
+        }
+
+        void insert( const QskTextMetricsCache::Key& key, const QRectF& rect )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.insert( key, new QRectF( rect ) );
+        }
+
+        void setCapacity( int capacity )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.setMaxCost( qMax( capacity, 0 ) );
+        }
+
+        int capacity()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_cache.maxCost();
+        }
+
+        void clear()
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_cache.clear();
+        }
+
+        QskTextMetricsCache::Statistics statistics()
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            auto statistics = m_statistics;
+            statistics.entries = m_cache.count();
+
+            return statistics;
+        }
+
+        void resetStatistics()
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_statistics = QskTextMetricsCache::Statistics();
+        }
+
+      private:
+        QMutex m_mutex;
+        QCache< QskTextMetricsCache::Key, QRectF > m_cache;
+
+        QskTextMetricsCache::Statistics m_statistics;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+bool QskTextMetricsCache::find( const Key& key, QRectF& rect )
+{
+    return qskCache->find( key, rect );
+}
+
+void QskTextMetricsCache::insert( const Key& key, const QRectF& rect )
+{
+    qskCache->insert( key, rect );
+}
+
+void QskTextMetricsCache::setCapacity( int capacity )
+{
+    qskCache->setCapacity( capacity );
+}
+
+int QskTextMetricsCache::capacity()
+{
+    return qskCache->capacity();
+}
+
+void QskTextMetricsCache::clear()
+{
+    qskCache->clear();
+}
+
+QskTextMetricsCache::Statistics QskTextMetricsCache::statistics()
+{
+    return qskCache->statistics();
+}
+
+void QskTextMetricsCache::resetStatistics()
+{
+    qskCache->resetStatistics();
+}
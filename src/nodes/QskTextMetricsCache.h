@@ -0,0 +1,75 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXT_METRICS_CACHE_H
+#define QSK_TEXT_METRICS_CACHE_H
+
+#include "QskGlobal.h"
+#include "QskTextOptions.h"
+
+#include <qfont.h>
+#include <qrect.h>
+#include <qstring.h>
+
+/*
+    A process wide LRU cache for the results of measuring texts, that
+    is used by QskTextRenderer::textSize(). Layouts ask for the size hints
+    of their children several times for each polish cycle, what ends up
+    in creating the same QTextLayouts again and again otherwise.
+ */
+namespace QskTextMetricsCache
+{
+    class QSK_EXPORT Key
+    {
+      public:
+        // the size of the text without any limitations
+        Key( const QString&, const QFont&, const QskTextOptions& );
+
+        // the rectangle of the text, when being layouted into size
+        Key( const QString&, const QFont&, const QskTextOptions&,
+            Qt::Alignment, const QSizeF& );
+
+        bool operator==( const Key& ) const noexcept;
+        inline QskHashValue hash() const noexcept { return m_hash; }
+
+      private:
+        QString m_text;
+        QFont m_font;
+        QskTextOptions m_options;
+        Qt::Alignment m_alignment;
+        QSizeF m_size;
+        bool m_isBounded;
+
+        QskHashValue m_hash;
+    };
+
+    QSK_EXPORT bool find( const Key&, QRectF& );
+    QSK_EXPORT void insert( const Key&, const QRectF& );
+
+    // maximum number of entries
+    QSK_EXPORT void setCapacity( int );
+    QSK_EXPORT int capacity();
+
+    QSK_EXPORT void clear();
+
+    class Statistics
+    {
+      public:
+        int entries = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+    };
+
+    QSK_EXPORT Statistics statistics();
+    QSK_EXPORT void resetStatistics();
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 ) noexcept
+    {
+        return key.hash() ^ seed;
+    }
+}
+
+#endif
@@ -7,6 +7,7 @@
 #include "QskPlainTextRenderer.h"
 #include "QskRichTextRenderer.h"
 #include "QskTextOptions.h"
+#include "QskTextMetricsCache.h"
 
 #include <qrect.h>
 
@@ -17,28 +18,45 @@
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options )
 {
-    if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-        return QskPlainTextRenderer::textSize( text, font, options );
-    else
-        return QskRichTextRenderer::textSize( text, font, options );
+    const QskTextMetricsCache::Key key( text, font, options );
+
+    QRectF r;
+    if ( !QskTextMetricsCache::find( key, r ) )
+    {
+        if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
+            r.setSize( QskPlainTextRenderer::textSize( text, font, options ) );
+        else
+            r.setSize( QskRichTextRenderer::textSize( text, font, options ) );
+
+        QskTextMetricsCache::insert( key, r );
+    }
+
+    return r.size();
 }
 
 QSizeF QskTextRenderer::textSize(
     const QString& text, const QFont& font, const QskTextOptions& options,
     const QSizeF& size )
 {
-    QRectF r;
+    const QskTextMetricsCache::Key key( text, font, options, Qt::Alignment(), size );
 
-    if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
-    {
-        r = QskPlainTextRenderer::textRect(
-            text, font, options, Qt::Alignment(), size );
-    }
-    else
+    QRectF r;
+    if ( !QskTextMetricsCache::find( key, r ) )
     {
-        r = QskRichTextRenderer::textRect(
-            text, font, options, Qt::Alignment(), size );
+        if ( options.effectiveFormat( text ) == QskTextOptions::PlainText )
+        {
+            r = QskPlainTextRenderer::textRect(
+                text, font, options, Qt::Alignment(), size );
+        }
+        else
+        {
+            r = QskRichTextRenderer::textRect(
+                text, font, options, Qt::Alignment(), size );
+        }
+
+        QskTextMetricsCache::insert( key, r );
     }
+
     return r.size();
 }
 
@@ -0,0 +1,206 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureAtlas.h"
+
+#include <qatomic.h>
+#include <qdebug.h>
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qimage.h>
+#include <qmap.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+static inline int qskDefaultSizeLimit()
+{
+    bool ok;
+
+    const int limit = qEnvironmentVariableIntValue( "QSK_ATLAS_SIZE_LIMIT", &ok );
+    return ok ? limit : 64;
+}
+
+static QAtomicInt qskSizeLimit = qskDefaultSizeLimit();
+
+namespace
+{
+    class Registry
+    {
+      public:
+        void insert( QSGTexture* texture )
+        {
+            /*
+                Atlas textures are sharing the comparison key of their page
+                and the size of the page can be calculated from the
+                normalized sub rectangle.
+             */
+            const auto subRect = texture->normalizedTextureSubRect();
+            const auto size = texture->textureSize();
+
+            Info info;
+            info.page = texture->comparisonKey();
+            info.pixels = qint64( size.width() ) * size.height();
+
+            if ( subRect.width() > 0.0 && subRect.height() > 0.0 )
+            {
+                info.pageSize = QSize( qRound( size.width() / subRect.width() ),
+                    qRound( size.height() / subRect.height() ) );
+            }
+
+            {
+                const QMutexLocker locker( &m_mutex );
+                m_textures.insert( texture, info );
+            }
+
+            // textures are deleted by the nodes or the texture cache
+            QObject::connect( texture, &QObject::destroyed,
+                [ this, texture ]() { remove( texture ); } );
+        }
+
+        void reject()
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_rejectedCount++;
+        }
+
+        QskTextureAtlas::Statistics statistics()
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            QskTextureAtlas::Statistics statistics;
+            statistics.atlasTextures = m_textures.count();
+            statistics.rejectedTextures = m_rejectedCount;
+            statistics.pages = pages().count();
+
+            return statistics;
+        }
+
+        void dump( QDebug debug )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            const QDebugStateSaver saver( debug );
+            debug.nospace();
+
+            const auto pages = this->pages();
+
+            debug << "QskTextureAtlas: " << m_textures.count() << " textures on "
+                << pages.count() << " pages, " << m_rejectedCount << " rejected";
+
+            for ( auto it = pages.constBegin(); it != pages.constEnd(); ++it )
+            {
+                const auto& page = it.value();
+
+                const qint64 area = qint64( page.size.width() ) * page.size.height();
+                const qreal occupancy = ( area > 0 ) ? 100.0 * page.pixels / area : 0.0;
+
+                debug << "\n    Page " << it.key() << ": "
+                    << page.size.width() << "x" << page.size.height()
+                    << ", " << page.count << " textures, "
+                    << qRound( occupancy * 10.0 ) / 10.0 << "% occupied";
+            }
+        }
+
+      private:
+        class Info
+        {
+          public:
+            qint64 page = 0;
+            QSize pageSize;
+            qint64 pixels = 0;
+        };
+
+        class Page
+        {
+          public:
+            QSize size;
+            int count = 0;
+            qint64 pixels = 0;
+        };
+
+        void remove( QSGTexture* texture )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_textures.remove( texture );
+        }
+
+        QMap< qint64, Page > pages() const
+        {
+            QMap< qint64, Page > pages;
+
+            for ( const auto& info : m_textures )
+            {
+                auto& page = pages[ info.page ];
+
+                page.size = page.size.expandedTo( info.pageSize );
+                page.count++;
+                page.pixels += info.pixels;
+            }
+
+            return pages;
+        }
+
+        QMutex m_mutex;
+
+        QHash< const QSGTexture*, Info > m_textures;
+        int m_rejectedCount = 0;
+    };
+}
+
+Q_GLOBAL_STATIC( Registry, qskRegistry )
+
+void QskTextureAtlas::setSizeLimit( int limit )
+{
+    qskSizeLimit.storeRelaxed( limit );
+}
+
+int QskTextureAtlas::sizeLimit()
+{
+    return qskSizeLimit.loadRelaxed();
+}
+
+bool QskTextureAtlas::isAtlasSize( const QSize& size )
+{
+    const int limit = sizeLimit();
+
+    return ( limit > 0 ) && !size.isEmpty()
+        && ( size.width() <= limit ) && ( size.height() <= limit );
+}
+
+QSGTexture* QskTextureAtlas::createTexture( QQuickWindow* window, const QImage& image )
+{
+    if ( !isAtlasSize( image.size() ) )
+        return window->createTextureFromImage( image );
+
+    auto texture = window->createTextureFromImage(
+        image, QQuickWindow::TextureCanUseAtlas );
+
+    if ( texture )
+    {
+        // the scene graph might decide not to use the atlas
+        if ( texture->isAtlasTexture() )
+            qskRegistry->insert( texture );
+        else
+            qskRegistry->reject();
+    }
+
+    return texture;
+}
+
+QskTextureAtlas::Statistics QskTextureAtlas::statistics()
+{
+    return qskRegistry->statistics();
+}
+
+void QskTextureAtlas::dumpOccupancy( QDebug debug )
+{
+    qskRegistry->dump( debug );
+}
+
+void QskTextureAtlas::dumpOccupancy()
+{
+    dumpOccupancy( qDebug() );
+}
@@ -0,0 +1,65 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_ATLAS_H
+#define QSK_TEXTURE_ATLAS_H
+
+#include "QskGlobal.h"
+
+class QQuickWindow;
+class QSGTexture;
+class QImage;
+class QSize;
+class QDebug;
+
+/*
+    Small images - f.e icons or symbols - are uploaded into the texture
+    atlas of the scene graph. Nodes with textures from the same atlas
+    can be batched, so that they are rendered with one draw call.
+
+    The atlas pages are managed by the scene graph. Here we keep track
+    of the textures we have created, so that we can tell how well
+    the pages are occupied.
+ */
+namespace QskTextureAtlas
+{
+    /*
+        Images, where width and height ( in device pixels ) do not exceed the limit,
+        are uploaded into the atlas. The default setting is 64, that can be
+        overwritten by the environment variable QSK_ATLAS_SIZE_LIMIT.
+        A limit <= 0 disables using the atlas.
+     */
+    void setSizeLimit( int );
+    int sizeLimit();
+
+    bool isAtlasSize( const QSize& );
+
+    /*
+        Creating a texture, that is in the atlas, when the image is small
+        enough and the scene graph supports atlas textures.
+     */
+    QSGTexture* createTexture( QQuickWindow*, const QImage& );
+
+    class Statistics
+    {
+      public:
+        // textures living in the atlas
+        int atlasTextures = 0;
+
+        // small images, that have been rejected by the scene graph
+        int rejectedTextures = 0;
+
+        // number of atlas pages in use
+        int pages = 0;
+    };
+
+    Statistics statistics();
+
+    // the occupancy of each atlas page - for tuning the size limit
+    void dumpOccupancy( QDebug );
+    void dumpOccupancy();
+}
+
+#endif
@@ -0,0 +1,310 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskTextureCache.h"
+
+#include <qglobalstatic.h>
+#include <qhash.h>
+#include <qmutex.h>
+#include <qquickwindow.h>
+#include <qsgtexture.h>
+
+bool QskTextureCache::Key::operator==( const Key& other ) const noexcept
+{
+    return ( hash == other.hash ) && ( window == other.window )
+        && ( size == other.size ) && ( devicePixelRatio == other.devicePixelRatio )
+        && ( renderHint == other.renderHint ) && ( identity == other.identity );
+}
+
+namespace
+{
+    class Entry
+    {
+      public:
+        QSGTexture* texture;
+        qint64 bytes;
+
+        // number of nodes using the texture
+        int refCount;
+
+        // for finding the least recently used textures
+        quint64 lastUsed;
+    };
+
+    class WindowCache
+    {
+      public:
+        QHash< QskTextureCache::Key, Entry > entries;
+        qint64 bytes = 0;
+
+        QMetaObject::Connection connection;
+    };
+
+    class Cache
+    {
+      public:
+        QSGTexture* acquire( const QskTextureCache::Key& key )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            const auto it = m_windowCaches.find( key.window );
+            if ( it != m_windowCaches.end() )
+            {
+                auto entry = it->entries.find( key );
+                if ( entry != it->entries.end() )
+                {
+                    entry->refCount++;
+                    entry->lastUsed = ++m_usageCounter;
+
+                    m_statistics.hits++;
+
+                    return entry->texture;
+                }
+            }
+
+            m_statistics.misses++;
+            return nullptr;
+        }
+
+        bool contains( const QskTextureCache::Key& key )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            const auto it = m_windowCaches.constFind( key.window );
+            return ( it != m_windowCaches.constEnd() ) && it->entries.contains( key );
+        }
+
+        void insert( const QskTextureCache::Key& key, QSGTexture* texture )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            auto it = m_windowCaches.find( key.window );
+            if ( it == m_windowCaches.end() )
+            {
+                it = m_windowCaches.insert( key.window, WindowCache() );
+
+                auto window = const_cast< QQuickWindow* >( key.window );
+
+                it->connection = QObject::connect(
+                    window, &QQuickWindow::sceneGraphInvalidated,
+                    [ this, window ]() { invalidate( window ); } );
+            }
+
+            auto& windowCache = *it;
+
+            const auto size = texture->textureSize();
+            const qint64 bytes = qint64( size.width() ) * size.height() * 4;
+
+            const Entry entry { texture, bytes, 1, ++m_usageCounter };
+
+            // nodes look up the cache before creating a texture
+            Q_ASSERT( !windowCache.entries.contains( key ) );
+
+            windowCache.entries.insert( key, entry );
+            windowCache.bytes += bytes;
+
+            m_textures.insert( texture, key );
+
+            m_statistics.entries++;
+            m_statistics.bytes += bytes;
+
+            evict( windowCache );
+        }
+
+        void release( QSGTexture* texture )
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            const auto key = m_textures.find( texture );
+            if ( key == m_textures.end() )
+                return;
+
+            auto it = m_windowCaches.find( key->window );
+            if ( it == m_windowCaches.end() )
+                return;
+
+            auto entry = it->entries.find( *key );
+            if ( entry != it->entries.end() )
+            {
+                // the texture is kept, until being evicted
+                if ( entry->refCount > 0 )
+                    entry->refCount--;
+            }
+        }
+
+        void setMaxEntries( int maxEntries )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_maxEntries = qMax( maxEntries, 0 );
+        }
+
+        int maxEntries()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_maxEntries;
+        }
+
+        void setMaxBytes( qint64 maxBytes )
+        {
+            const QMutexLocker locker( &m_mutex );
+            m_maxBytes = qMax( maxBytes, qint64( 0 ) );
+        }
+
+        qint64 maxBytes()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_maxBytes;
+        }
+
+        QskTextureCache::Statistics statistics()
+        {
+            const QMutexLocker locker( &m_mutex );
+            return m_statistics;
+        }
+
+        void resetStatistics()
+        {
+            const QMutexLocker locker( &m_mutex );
+
+            m_statistics.hits = 0;
+            m_statistics.misses = 0;
+            m_statistics.evictions = 0;
+        }
+
+      private:
+        void invalidate( const QQuickWindow* window )
+        {
+            // called from the render thread, when all nodes have been deleted
+
+            const QMutexLocker locker( &m_mutex );
+
+            auto it = m_windowCaches.find( window );
+            if ( it == m_windowCaches.end() )
+                return;
+
+            QObject::disconnect( it->connection );
+
+            for ( auto entry = it->entries.begin(); entry != it->entries.end(); ++entry )
+            {
+                m_textures.remove( entry->texture );
+                delete entry->texture;
+            }
+
+            m_statistics.entries -= it->entries.count();
+            m_statistics.bytes -= it->bytes;
+
+            m_windowCaches.erase( it );
+        }
+
+        void evict( WindowCache& windowCache )
+        {
+            /*
+                Evicting happens only when inserting a texture in the
+                render thread of the window. So we never delete textures
+                of other scene graphs.
+             */
+            while ( ( windowCache.entries.count() > m_maxEntries )
+                || ( windowCache.bytes > m_maxBytes ) )
+            {
+                auto lru = windowCache.entries.end();
+
+                for ( auto it = windowCache.entries.begin();
+                    it != windowCache.entries.end(); ++it )
+                {
+                    if ( it->refCount > 0 )
+                        continue;
+
+                    if ( lru == windowCache.entries.end() || it->lastUsed < lru->lastUsed )
+                        lru = it;
+                }
+
+                if ( lru == windowCache.entries.end() )
+                    break; // all textures are in use
+
+                remove( windowCache, lru );
+                m_statistics.evictions++;
+            }
+        }
+
+        void remove( WindowCache& windowCache,
+            QHash< QskTextureCache::Key, Entry >::iterator it )
+        {
+            windowCache.bytes -= it->bytes;
+
+            m_statistics.entries--;
+            m_statistics.bytes -= it->bytes;
+
+            m_textures.remove( it->texture );
+            delete it->texture;
+
+            windowCache.entries.erase( it );
+        }
+
+        QMutex m_mutex;
+
+        QHash< const QQuickWindow*, WindowCache > m_windowCaches;
+
+        // for finding the key of a texture
+        QHash< const QSGTexture*, QskTextureCache::Key > m_textures;
+
+        int m_maxEntries = 200;
+        qint64 m_maxBytes = 16 * 1024 * 1024;
+
+        quint64 m_usageCounter = 0;
+        QskTextureCache::Statistics m_statistics;
+    };
+}
+
+Q_GLOBAL_STATIC( Cache, qskCache )
+
+QSGTexture* QskTextureCache::acquire( const Key& key )
+{
+    return qskCache->acquire( key );
+}
+
+bool QskTextureCache::contains( const Key& key )
+{
+    return qskCache->contains( key );
+}
+
+void QskTextureCache::insert( const Key& key, QSGTexture* texture )
+{
+    qskCache->insert( key, texture );
+}
+
+void QskTextureCache::release( QSGTexture* texture )
+{
+    qskCache->release( texture );
+}
+
+void QskTextureCache::setMaxEntries( int maxEntries )
+{
+    qskCache->setMaxEntries( maxEntries );
+}
+
+int QskTextureCache::maxEntries()
+{
+    return qskCache->maxEntries();
+}
+
+void QskTextureCache::setMaxBytes( qint64 maxBytes )
+{
+    qskCache->setMaxBytes( maxBytes );
+}
+
+qint64 QskTextureCache::maxBytes()
+{
+    return qskCache->maxBytes();
+}
+
+QskTextureCache::Statistics QskTextureCache::statistics()
+{
+    return qskCache->statistics();
+}
+
+void QskTextureCache::resetStatistics()
+{
+    qskCache->resetStatistics();
+}
@@ -0,0 +1,96 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_TEXTURE_CACHE_H
+#define QSK_TEXTURE_CACHE_H
+
+#include "QskGlobal.h"
+#include <qbytearray.h>
+#include <qhash.h>
+#include <qsize.h>
+
+class QQuickWindow;
+class QSGTexture;
+
+/*
+    Textures of painted nodes, that can be shared between nodes
+    showing the same content - f.e the icons of the rows of a list.
+
+    Textures are scoped to the window, so that they are created/deleted
+    in the render thread of the scene graph, they belong to. They are
+    released, when the scene graph of the window is invalidated.
+
+    Textures are referenced by the nodes using them. Unreferenced textures are
+    kept until the number/memory of the textures of a window exceeds the limits.
+    Then the least recently used ones are deleted.
+ */
+namespace QskTextureCache
+{
+    class Key
+    {
+      public:
+        bool operator==( const Key& ) const noexcept;
+
+        const QQuickWindow* window;
+
+        // a hash value for the content
+        QskHashValue hash;
+
+        /*
+            The hash value is not unique, so the content has to be identified
+            by something, that can be compared: see QskPaintedNode::identity
+         */
+        QByteArray identity;
+
+        QSize size;
+        qreal devicePixelRatio;
+
+        // a hint for the type of texture
+        int renderHint;
+    };
+
+    // returns a texture with an additional reference or nullptr
+    QSGTexture* acquire( const Key& );
+
+    // without counting hits/misses or changing references
+    bool contains( const Key& );
+
+    // the texture is owned by the cache and has one reference
+    void insert( const Key&, QSGTexture* );
+
+    // removing the reference of texture from acquire/insert
+    void release( QSGTexture* );
+
+    // limits for each window, applied when inserting
+    void setMaxEntries( int );
+    int maxEntries();
+
+    void setMaxBytes( qint64 );
+    qint64 maxBytes();
+
+    class Statistics
+    {
+      public:
+        int entries = 0;
+        qint64 bytes = 0;
+
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    Statistics statistics();
+
+    // resetting hits, misses and evictions
+    void resetStatistics();
+
+    inline QskHashValue qHash( const Key& key, QskHashValue seed = 0 ) noexcept
+    {
+        return ::qHash( key.hash, seed ) ^ ::qHash( key.size.width() )
+            ^ ::qHash( key.size.height() );
+    }
+}
+
+#endif
@@ -0,0 +1,132 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#include "QskVectorGraphicNode.h"
+#include "QskGraphic.h"
+#include "QskGraphicTessellation.h"
+#include "QskColorFilter.h"
+#include "QskVertex.h"
+#include "QskFillNodePrivate.h"
+
+static QTransform qskTransform( const QskGraphic& graphic,
+    const QRectF& rect, Qt::Orientations mirrored )
+{
+    /*
+        The same mapping as QskGraphic::render( painter, rect,
+        colorFilter, Qt::IgnoreAspectRatio ) for graphics with scalable pens
+     */
+    auto box = graphic.viewBox();
+    if ( box.isEmpty() )
+        box = graphic.boundingRect();
+
+    QTransform transform;
+
+    if ( box.width() > 0.0 && box.height() > 0.0 )
+    {
+        transform.translate( rect.x(), rect.y() );
+        transform.scale( rect.width() / box.width(), rect.height() / box.height() );
+        transform.translate( -box.x(), -box.y() );
+    }
+
+    if ( mirrored )
+    {
+        const bool h = mirrored & Qt::Horizontal;
+        const bool v = mirrored & Qt::Vertical;
+
+        const QTransform m( h ? -1.0 : 1.0, 0.0, 0.0, v ? -1.0 : 1.0,
+            h ? rect.left() + rect.right() : 0.0,
+            v ? rect.top() + rect.bottom() : 0.0 );
+
+        transform *= m;
+    }
+
+    return transform;
+}
+
+class QskVectorGraphicNodePrivate final : public QskFillNodePrivate
+{
+  public:
+    QskGraphic graphic;
+    QskColorFilter colorFilter;
+    QRectF rect;
+    Qt::Orientations mirrored;
+};
+
+QskVectorGraphicNode::QskVectorGraphicNode()
+    : QskFillNode( *new QskVectorGraphicNodePrivate )
+{
+    setColoring( Polychrome );
+    geometry()->setDrawingMode( QSGGeometry::DrawTriangles );
+}
+
+QskVectorGraphicNode::~QskVectorGraphicNode()
+{
+}
+
+bool QskVectorGraphicNode::isSupported( const QskGraphic& graphic )
+{
+    return !graphic.tessellation().isNull();
+}
+
+void QskVectorGraphicNode::setGraphic( const QskGraphic& graphic,
+    const QskColorFilter& colorFilter, const QRectF& rect, Qt::Orientations mirrored )
+{
+    Q_D( QskVectorGraphicNode );
+
+    if ( ( graphic == d->graphic ) && ( colorFilter == d->colorFilter )
+        && ( rect == d->rect ) && ( mirrored == d->mirrored ) )
+    {
+        return;
+    }
+
+    d->graphic = graphic;
+    d->colorFilter = colorFilter;
+    d->rect = rect;
+    d->mirrored = mirrored;
+
+    const auto tessellation = graphic.tessellation();
+
+    if ( rect.isEmpty() || tessellation.isNull() )
+    {
+        resetGeometry();
+        return;
+    }
+
+    auto geometry = this->geometry();
+
+    geometry->allocate( tessellation.vertexCount() );
+    auto points = geometry->vertexDataAsColoredPoint2D();
+
+    for ( const auto& area : tessellation.areas() )
+    {
+        QColor c = QColor::fromRgba( colorFilter.substituted( area.color ) );
+        if ( area.opacity < 1.0f )
+            c.setAlphaF( c.alphaF() * area.opacity );
+
+        const auto count = area.vertices.size() / 2;
+
+        QskVertex::fillPoints( count, area.vertices.constData(), c, points );
+        points += count;
+    }
+
+    // the vertices are in coordinates of the graphic
+
+    const auto transform = qskTransform( graphic, rect, mirrored );
+
+    points = geometry->vertexDataAsColoredPoint2D();
+
+    for ( int i = 0; i < geometry->vertexCount(); i++ )
+    {
+        auto& p = points[ i ];
+
+        const auto pos = transform.map( QPointF( p.x, p.y ) );
+
+        p.x = static_cast< float >( pos.x() );
+        p.y = static_cast< float >( pos.y() );
+    }
+
+    geometry->markVertexDataDirty();
+    markDirty( QSGNode::DirtyGeometry );
+}
@@ -0,0 +1,41 @@
+/******************************************************************************
+ * QSkinny - Copyright (C) The authors
+ *           SPDX-License-Identifier: BSD-3-Clause
+ *****************************************************************************/
+
+#ifndef QSK_VECTOR_GRAPHIC_NODE_H
+#define QSK_VECTOR_GRAPHIC_NODE_H
+
+#include "QskGlobal.h"
+#include "QskFillNode.h"
+
+class QskGraphic;
+class QskColorFilter;
+
+class QskVectorGraphicNodePrivate;
+
+/*
+    Rendering the QskGraphic::tessellation() of a graphic as one geometry
+    with colored points. In opposite to QskGraphicNode there is no need
+    for rasterizing the graphic and uploading a texture, what makes it
+    a good choice for icons in many different sizes.
+ */
+class QSK_EXPORT QskVectorGraphicNode : public QskFillNode
+{
+    using Inherited = QskFillNode;
+
+  public:
+    QskVectorGraphicNode();
+    ~QskVectorGraphicNode() override;
+
+    void setGraphic( const QskGraphic&, const QskColorFilter&,
+        const QRectF&, Qt::Orientations mirrored = Qt::Orientations() );
+
+    // true, when the graphic has a tessellation
+    static bool isSupported( const QskGraphic& );
+
+  private:
+    Q_DECLARE_PRIVATE( QskVectorGraphicNode )
+};
+
+#endif
@@ -4,9 +4,486 @@
  *****************************************************************************/
 
 #include "QskVertex.h"
+#include "QskVertexHelper.h"
+
+#include <qmutex.h>
+#include <qtransform.h>
+
+#include <map>
+#include <vector>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) \
+    || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+
+#define QSK_VERTEX_SSE2
+#include <emmintrin.h>
+
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+
+// vcvt_f32_f64 is not available for 32 bit ARM
+#define QSK_VERTEX_NEON
+#include <arm_neon.h>
+
+#endif
 
 using namespace QskVertex;
 
+namespace
+{
+    class ArcTables
+    {
+      public:
+        ArcTables()
+        {
+            int offset = 0;
+
+            for ( int i = 0; i <= ArcIterator::MaxStepCount; i++ )
+            {
+                m_offsets[ i ] = offset;
+                offset += i + 1;
+            }
+
+            m_values.resize( offset );
+
+            for ( int i = 1; i <= ArcIterator::MaxStepCount; i++ )
+                initTable( i, m_values.data() + m_offsets[ i ] );
+        }
+
+        const qreal* table( int stepCount )
+        {
+            if ( stepCount >= 1 && stepCount <= ArcIterator::MaxStepCount )
+                return m_values.data() + m_offsets[ stepCount ];
+
+            // should never happen with step counts from segmentHint
+
+            const QMutexLocker locker( &m_mutex );
+
+            auto& values = m_extraValues[ stepCount ];
+            if ( values.empty() )
+            {
+                values.resize( qMax( stepCount, 0 ) + 1 );
+                initTable( stepCount, values.data() );
+            }
+
+            return values.data();
+        }
+
+      private:
+        static void initTable( int stepCount, qreal* values )
+        {
+            if ( stepCount <= 0 )
+            {
+                values[ 0 ] = 1.0;
+                return;
+            }
+
+            const auto angleStep = M_PI_2 / stepCount;
+
+            for ( int i = 0; i <= stepCount; i++ )
+                values[ i ] = qSin( i * angleStep );
+
+            // avoiding fuzzy compares, when checking for the end points
+            values[ 0 ] = 0.0;
+            values[ stepCount ] = 1.0;
+        }
+
+        int m_offsets[ ArcIterator::MaxStepCount + 1 ];
+        std::vector< qreal > m_values;
+
+        QMutex m_mutex;
+        std::map< int, std::vector< qreal > > m_extraValues;
+    };
+}
+
+Q_GLOBAL_STATIC( ArcTables, qskArcTables )
+
+const qreal* QskVertex::arcTable( int stepCount )
+{
+    return qskArcTables->table( stepCount );
+}
+
+namespace
+{
+    /*
+        The scalar implementations are the reference for the vectorized
+        code: both do the same double operations in the same order followed
+        by a conversion to float with round to nearest. So the results are
+        identical - as long as the compiler does not contract the scalar
+        code into fused multiply-adds, what is the default for GCC/clang
+        on aarch64. That's why this file is compiled with -ffp-contract=off.
+     */
+
+    template< typename T >
+    inline void setPoint( QSGGeometry::Point2D& point, T x, T y )
+    {
+        point.x = static_cast< float >( x );
+        point.y = static_cast< float >( y );
+    }
+
+    template< typename T >
+    inline void setPoint( QSGGeometry::ColoredPoint2D& point, T x, T y, Color c )
+    {
+        point.set( static_cast< float >( x ), static_cast< float >( y ),
+            c.r, c.g, c.b, c.a );
+    }
+
+    class AffineMatrix
+    {
+      public:
+        inline AffineMatrix( const QTransform& transform )
+            : m11( transform.m11() )
+            , m12( transform.m12() )
+            , m21( transform.m21() )
+            , m22( transform.m22() )
+            , dx( transform.dx() )
+            , dy( transform.dy() )
+        {
+        }
+
+        inline qreal mapX( qreal x, qreal y ) const { return m11 * x + m21 * y + dx; }
+        inline qreal mapY( qreal x, qreal y ) const { return m12 * x + m22 * y + dy; }
+
+        const qreal m11, m12, m21, m22, dx, dy;
+    };
+}
+
+#if defined( QSK_VERTEX_SSE2 ) || defined( QSK_VERTEX_NEON )
+
+/*
+    qreal might be float for some embedded platforms, where we
+    end up in the scalar implementations below
+ */
+
+static inline void qskStoreColor( Color c, QSGGeometry::ColoredPoint2D& point )
+{
+    point.r = c.r;
+    point.g = c.g;
+    point.b = c.b;
+    point.a = c.a;
+}
+
+#if defined( QSK_VERTEX_SSE2 )
+
+static inline void qskFillPoints( int count,
+    const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = _mm_cvtpd_ps( _mm_loadu_pd( xy + 2 * i ) );
+        const auto p2 = _mm_cvtpd_ps( _mm_loadu_pd( xy + 2 * i + 2 ) );
+
+        _mm_storeu_ps( out + 2 * i, _mm_movelh_ps( p1, p2 ) );
+    }
+
+    for ( ; i < count; i++ )
+        setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ] );
+}
+
+static inline void qskFillPoints( const AffineMatrix& m,
+    int count, const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    const auto m11 = _mm_set1_pd( m.m11 );
+    const auto m12 = _mm_set1_pd( m.m12 );
+    const auto m21 = _mm_set1_pd( m.m21 );
+    const auto m22 = _mm_set1_pd( m.m22 );
+    const auto dx = _mm_set1_pd( m.dx );
+    const auto dy = _mm_set1_pd( m.dy );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = _mm_loadu_pd( xy + 2 * i );
+        const auto p2 = _mm_loadu_pd( xy + 2 * i + 2 );
+
+        const auto x = _mm_unpacklo_pd( p1, p2 );
+        const auto y = _mm_unpackhi_pd( p1, p2 );
+
+        const auto mx = _mm_add_pd( _mm_add_pd(
+            _mm_mul_pd( m11, x ), _mm_mul_pd( m21, y ) ), dx );
+
+        const auto my = _mm_add_pd( _mm_add_pd(
+            _mm_mul_pd( m12, x ), _mm_mul_pd( m22, y ) ), dy );
+
+        const auto f1 = _mm_cvtpd_ps( _mm_unpacklo_pd( mx, my ) );
+        const auto f2 = _mm_cvtpd_ps( _mm_unpackhi_pd( mx, my ) );
+
+        _mm_storeu_ps( out + 2 * i, _mm_movelh_ps( f1, f2 ) );
+    }
+
+    for ( ; i < count; i++ )
+    {
+        const auto x = xy[ 2 * i ];
+        const auto y = xy[ 2 * i + 1 ];
+
+        setPoint( points[i], m.mapX( x, y ), m.mapY( x, y ) );
+    }
+}
+
+static inline void qskFillPoints( int count, const quint16* indices,
+    const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = _mm_cvtpd_ps( _mm_loadu_pd( xy + 2 * indices[i] ) );
+        const auto p2 = _mm_cvtpd_ps( _mm_loadu_pd( xy + 2 * indices[i + 1] ) );
+
+        _mm_storeu_ps( out + 2 * i, _mm_movelh_ps( p1, p2 ) );
+    }
+
+    for ( ; i < count; i++ )
+    {
+        const int j = 2 * indices[i];
+        setPoint( points[i], xy[j], xy[j + 1] );
+    }
+}
+
+static inline void qskFillPoints( int count, const quint16* indices,
+    const double* xy, Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto p = _mm_cvtpd_ps( _mm_loadu_pd( xy + 2 * indices[i] ) );
+
+        _mm_storel_pi( reinterpret_cast< __m64* >( &points[i].x ), p );
+        qskStoreColor( color, points[i] );
+    }
+}
+
+static inline void qskFillPoints( int count, const float* xy,
+    Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p = _mm_loadu_ps( xy + 2 * i );
+
+        _mm_storel_pi( reinterpret_cast< __m64* >( &points[i].x ), p );
+        _mm_storeh_pi( reinterpret_cast< __m64* >( &points[i + 1].x ), p );
+
+        qskStoreColor( color, points[i] );
+        qskStoreColor( color, points[i + 1] );
+    }
+
+    for ( ; i < count; i++ )
+        setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ], color );
+}
+
+#else // QSK_VERTEX_NEON
+
+static inline void qskFillPoints( int count,
+    const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = vcvt_f32_f64( vld1q_f64( xy + 2 * i ) );
+        const auto p2 = vcvt_f32_f64( vld1q_f64( xy + 2 * i + 2 ) );
+
+        vst1q_f32( out + 2 * i, vcombine_f32( p1, p2 ) );
+    }
+
+    for ( ; i < count; i++ )
+        setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ] );
+}
+
+static inline void qskFillPoints( const AffineMatrix& m,
+    int count, const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    const auto m11 = vdupq_n_f64( m.m11 );
+    const auto m12 = vdupq_n_f64( m.m12 );
+    const auto m21 = vdupq_n_f64( m.m21 );
+    const auto m22 = vdupq_n_f64( m.m22 );
+    const auto dx = vdupq_n_f64( m.dx );
+    const auto dy = vdupq_n_f64( m.dy );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = vld1q_f64( xy + 2 * i );
+        const auto p2 = vld1q_f64( xy + 2 * i + 2 );
+
+        const auto x = vzip1q_f64( p1, p2 );
+        const auto y = vzip2q_f64( p1, p2 );
+
+        // no fused multiply-add to get the same results as the scalar code
+        const auto mx = vaddq_f64( vaddq_f64(
+            vmulq_f64( m11, x ), vmulq_f64( m21, y ) ), dx );
+
+        const auto my = vaddq_f64( vaddq_f64(
+            vmulq_f64( m12, x ), vmulq_f64( m22, y ) ), dy );
+
+        const auto f1 = vcvt_f32_f64( vzip1q_f64( mx, my ) );
+        const auto f2 = vcvt_f32_f64( vzip2q_f64( mx, my ) );
+
+        vst1q_f32( out + 2 * i, vcombine_f32( f1, f2 ) );
+    }
+
+    for ( ; i < count; i++ )
+    {
+        const auto x = xy[ 2 * i ];
+        const auto y = xy[ 2 * i + 1 ];
+
+        setPoint( points[i], m.mapX( x, y ), m.mapY( x, y ) );
+    }
+}
+
+static inline void qskFillPoints( int count, const quint16* indices,
+    const double* xy, QSGGeometry::Point2D* points )
+{
+    auto out = reinterpret_cast< float* >( points );
+
+    int i = 0;
+    for ( ; i + 2 <= count; i += 2 )
+    {
+        const auto p1 = vcvt_f32_f64( vld1q_f64( xy + 2 * indices[i] ) );
+        const auto p2 = vcvt_f32_f64( vld1q_f64( xy + 2 * indices[i + 1] ) );
+
+        vst1q_f32( out + 2 * i, vcombine_f32( p1, p2 ) );
+    }
+
+    for ( ; i < count; i++ )
+    {
+        const int j = 2 * indices[i];
+        setPoint( points[i], xy[j], xy[j + 1] );
+    }
+}
+
+static inline void qskFillPoints( int count, const quint16* indices,
+    const double* xy, Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const auto p = vcvt_f32_f64( vld1q_f64( xy + 2 * indices[i] ) );
+
+        vst1_f32( &points[i].x, p );
+        qskStoreColor( color, points[i] );
+    }
+}
+
+static inline void qskFillPoints( int count, const float* xy,
+    Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        vst1_f32( &points[i].x, vld1_f32( xy + 2 * i ) );
+        qskStoreColor( color, points[i] );
+    }
+}
+
+#endif
+
+#endif
+
+// scalar implementations
+
+template< typename T >
+static inline void qskFillPoints( int count,
+    const T* xy, QSGGeometry::Point2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+        setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ] );
+}
+
+template< typename T >
+static inline void qskFillPoints( const AffineMatrix& m,
+    int count, const T* xy, QSGGeometry::Point2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const qreal x = xy[ 2 * i ];
+        const qreal y = xy[ 2 * i + 1 ];
+
+        setPoint( points[i], m.mapX( x, y ), m.mapY( x, y ) );
+    }
+}
+
+template< typename T >
+static inline void qskFillPoints( int count, const quint16* indices,
+    const T* xy, QSGGeometry::Point2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const int j = 2 * indices[i];
+        setPoint( points[i], xy[j], xy[j + 1] );
+    }
+}
+
+template< typename T >
+static inline void qskFillPoints( int count, const quint16* indices,
+    const T* xy, Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+    {
+        const int j = 2 * indices[i];
+        setPoint( points[i], xy[j], xy[j + 1], color );
+    }
+}
+
+template< typename T >
+static inline void qskFillPoints( int count, const T* xy,
+    Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    for ( int i = 0; i < count; i++ )
+        setPoint( points[i], xy[ 2 * i ], xy[ 2 * i + 1 ], color );
+}
+
+void QskVertex::fillPoints( int count,
+    const qreal* xy, QSGGeometry::Point2D* points )
+{
+    qskFillPoints( count, xy, points );
+}
+
+void QskVertex::fillPoints( const QTransform& transform,
+    int count, const qreal* xy, QSGGeometry::Point2D* points )
+{
+    if ( transform.isIdentity() )
+    {
+        qskFillPoints( count, xy, points );
+    }
+    else if ( transform.isAffine() )
+    {
+        qskFillPoints( AffineMatrix( transform ), count, xy, points );
+    }
+    else
+    {
+        for ( int i = 0; i < count; i++ )
+        {
+            const auto pos = transform.map( QPointF( xy[ 2 * i ], xy[ 2 * i + 1 ] ) );
+            setPoint( points[i], pos.x(), pos.y() );
+        }
+    }
+}
+
+void QskVertex::fillPoints( int count, const quint16* indices,
+    const qreal* xy, QSGGeometry::Point2D* points )
+{
+    qskFillPoints( count, indices, xy, points );
+}
+
+void QskVertex::fillPoints( int count, const quint16* indices,
+    const qreal* xy, Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    qskFillPoints( count, indices, xy, color, points );
+}
+
+void QskVertex::fillPoints( int count, const float* xy,
+    Color color, QSGGeometry::ColoredPoint2D* points )
+{
+    qskFillPoints( count, xy, color, points );
+}
+
 #ifndef QT_NO_DEBUG_STREAM
 
 #include <qdebug.h>
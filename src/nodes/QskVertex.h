@@ -12,6 +12,8 @@
 #include <qsggeometry.h>
 #include <qline.h>
 
+class QTransform;
+
 namespace QskVertex
 {
     class Color
@@ -215,6 +217,34 @@ namespace QskVertex
     }
 }
 
+namespace QskVertex
+{
+    /*
+        Filling vertex buffers from coordinates ( x0, y0, x1, y1, ... ),
+        like being found in QTriangleSet, QLineF arrays or the vertices
+        of QTriangulatingStroker.
+
+        SSE2/NEON instructions are used when being available for the
+        target, otherwise the same results are calculated without.
+        playground/vertexbenchmark verifies, that all kernels match
+        the scalar implementation bit for bit.
+     */
+
+    QSK_EXPORT void fillPoints( int count, const qreal* xy, QSGGeometry::Point2D* );
+
+    QSK_EXPORT void fillPoints( const QTransform&, int count,
+        const qreal* xy, QSGGeometry::Point2D* );
+
+    QSK_EXPORT void fillPoints( int count, const quint16* indices,
+        const qreal* xy, QSGGeometry::Point2D* );
+
+    QSK_EXPORT void fillPoints( int count, const quint16* indices,
+        const qreal* xy, Color, QSGGeometry::ColoredPoint2D* );
+
+    QSK_EXPORT void fillPoints( int count, const float* xy,
+        Color, QSGGeometry::ColoredPoint2D* );
+}
+
 namespace QskVertex
 {
     void debugGeometry( const QSGGeometry& );
@@ -14,9 +14,20 @@
 
 namespace QskVertex
 {
+    /*
+        sin( i * M_PI_2 / stepCount ) for i = 0 ... stepCount
+
+        The tables are calculated once and shared for all geometries,
+        so that iterating along the corners of a box is reduced to
+        table lookups and multiply-adds.
+     */
+    const qreal* arcTable( int stepCount );
+
     class ArcIterator
     {
       public:
+        enum { MaxStepCount = 18 };
+
         inline ArcIterator() = default;
 
         inline ArcIterator( int stepCount, bool inverted = false )
@@ -28,87 +39,53 @@ namespace QskVertex
         {
             m_inverted = inverted;
 
-            if ( inverted )
-            {
-                m_cos = 1.0;
-                m_sin = 0.0;
-            }
-            else
-            {
-                m_cos = 0.0;
-                m_sin = 1.0;
-            }
-
             m_stepIndex = 0;
             m_stepCount = stepCount;
 
-            const auto angleStep = M_PI_2 / stepCount;
-            m_cosStep = qFastCos( angleStep );
-            m_sinStep = qFastSin( angleStep );
+            m_values = arcTable( stepCount );
         }
 
         inline bool isInverted() const { return m_inverted; }
 
-        inline qreal cos() const { return m_cos; }
-        inline qreal sin() const { return m_inverted ? -m_sin : m_sin; }
+        /*
+            The angle goes from 90° to 0°, or from 0° to 90° when being
+            inverted. So cos/sin are found in the same table:
 
-        inline int step() const { return m_stepIndex; }
-        inline int stepCount() const { return m_stepCount; }
-        inline bool isDone() const { return m_stepIndex > m_stepCount; }
+                - cos: table[ step ], inverted: table[ stepCount - step ]
+                - sin: table[ stepCount - step ], inverted: table[ step ]
+         */
 
-        inline void increment()
+        inline qreal cos() const
         {
-            if ( ++m_stepIndex >= m_stepCount )
-            {
-                if ( m_stepIndex == m_stepCount )
-                {
-                    /*
-                        Doubles are not numerical stable and the small errors,
-                        sum up when iterating in steps. To avoid having to deal with
-                        fuzzy compares we manually fix cos/sin at the end.
-                     */
-                    if ( m_inverted )
-                    {
-                        m_cos = 0.0;
-                        m_sin = -1.0;
-                    }
-                    else
-                    {
-                        m_cos = 1.0;
-                        m_sin = 0.0;
-                    }
-                }
-            }
-            else
-            {
-                const auto cos0 = m_cos;
-
-                m_cos = m_cos * m_cosStep + m_sin * m_sinStep;
-                m_sin = m_sin * m_cosStep - cos0 * m_sinStep;
-            }
+            const auto i = index();
+            return m_values[ m_inverted ? m_stepCount - i : i ];
         }
 
-        inline void decrement()
+        inline qreal sin() const
         {
-            revert();
-            increment();
-            revert();
+            const auto i = index();
+            return m_values[ m_inverted ? i : m_stepCount - i ];
         }
 
+        inline int step() const { return m_stepIndex; }
+        inline int stepCount() const { return m_stepCount; }
+        inline bool isDone() const { return m_stepIndex > m_stepCount; }
+
+        inline void increment() { m_stepIndex++; }
+        inline void decrement() { m_stepIndex--; }
+
         inline void operator++() { increment(); }
 
         static int segmentHint( qreal radius )
         {
             const auto arcLength = radius * M_PI_2;
-            return qBound( 3, qCeil( arcLength / 3.0 ), 18 ); // every 3 pixels
+            return qBound( 3, qCeil( arcLength / 3.0 ), int( MaxStepCount ) ); // every 3 pixels
         }
 
         inline void revert()
         {
             m_inverted = !m_inverted;
             m_stepIndex = m_stepCount - m_stepIndex;
-
-            m_sin = -m_sin;
         }
 
         ArcIterator reverted() const
@@ -120,14 +97,17 @@ namespace QskVertex
         }
 
       private:
-        qreal m_cos;
-        qreal m_sin;
+        inline int index() const
+        {
+            // beyond the last step the values of the last step are reported
+            return qBound( 0, m_stepIndex, m_stepCount );
+        }
 
-        int m_stepIndex;
-        qreal m_cosStep;
-        qreal m_sinStep;
+        const qreal* m_values;
 
+        int m_stepIndex;
         int m_stepCount;
+
         bool m_inverted;
     };
 }
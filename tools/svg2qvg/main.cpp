@@ -10,19 +10,47 @@
 #include <QskPainterCommand.cpp>
 #include <QskGraphicPaintEngine.cpp>
 #include <QskGraphicIO.cpp>
+#include <QskGraphicTessellation.cpp>
 #else
 #include <QskGraphicIO.h>
 #include <QskGraphic.h>
+#include <QskGraphicTessellation.h>
 #endif
 
 #include <QGuiApplication>
 #include <QSvgRenderer>
 #include <QPainter>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QThreadPool>
 #include <QDebug>
 
+#include <atomic>
+
 static void usage( const char* appName )
 {
-    qWarning() << "usage: " << appName << "<svgfile> <qvgfile>";
+    qWarning() << "usage: " << appName
+        << "[--mappable] [--tessellate] <svgfile> <qvgfile>";
+
+    qWarning() << "       " << appName
+        << "[--mappable] [--tessellate] [--jobs <n>] --batch <manifest>";
+
+    qWarning() << "    --mappable: write the format for memory mapped loading, "
+        "that can only be read on platforms with the same byte order";
+
+    qWarning() << "    --tessellate: store triangles for rendering the graphic "
+        "without textures ( implies --mappable )";
+
+    qWarning() << "    --batch: convert all files of the manifest in parallel. "
+        "Each line of the manifest has a svg and a qvg file separated by a tab, "
+        "lines starting with -- are additional options. Files, that have not "
+        "been modified since the previous run, are skipped";
+
+    qWarning() << "    --jobs: number of threads for the batch mode";
 }
 
 static QRectF viewBox( QSvgRenderer& renderer )
@@ -63,14 +91,231 @@ class Graphic : public QskGraphic
     }
 };
 
-int main( int argc, char* argv[] )
+namespace
 {
-    if ( argc != 3 )
+    class Options
     {
-        usage( argv[0] );
-        return -1;
+      public:
+        bool parse( const QString& arg )
+        {
+            if ( arg == QLatin1String( "--mappable" ) )
+            {
+                format = QskGraphicIO::MappableFormat;
+                return true;
+            }
+
+            if ( arg == QLatin1String( "--tessellate" ) )
+            {
+                format = QskGraphicIO::MappableFormat;
+                tessellate = true;
+                return true;
+            }
+
+            return false;
+        }
+
+        QByteArray signature() const
+        {
+            // files have to be converted again, when the options change
+            return QByteArray::number( format ) + ( tessellate ? "t" : "" );
+        }
+
+        QskGraphicIO::Format format = QskGraphicIO::StreamFormat;
+        bool tessellate = false;
+    };
+
+    class Job
+    {
+      public:
+        QString svgFile;
+        QString qvgFile;
+        QByteArray hash;
+    };
+}
+
+static bool convert( const QByteArray& svgData,
+    const QString& svgFile, const QString& qvgFile, const Options& options )
+{
+    QSvgRenderer renderer;
+    if ( !renderer.load( svgData ) )
+    {
+        qWarning() << "Can't load" << svgFile;
+        return false;
+    }
+
+    Graphic graphic;
+    graphic.setViewBox( ::viewBox( renderer ) );
+
+    QPainter painter( &graphic );
+    renderer.render( &painter );
+    painter.end();
+
+    if ( graphic.commandTypes() & QskGraphic::RasterData )
+        qWarning() << svgFile << "contains non scalable parts.";
+
+    if ( options.tessellate )
+    {
+        const auto tessellation = QskGraphicTessellation::tessellate( graphic );
+        if ( tessellation.isNull() )
+            qWarning() << svgFile << "can't be tessellated.";
+
+        graphic.setTessellation( tessellation );
+    }
+
+    return QskGraphicIO::write( graphic, qvgFile, options.format );
+}
+
+static QByteArray readFile( const QString& fileName )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::ReadOnly ) )
+        return QByteArray();
+
+    return file.readAll();
+}
+
+static QHash< QString, QByteArray > readHashes( const QString& fileName )
+{
+    QHash< QString, QByteArray > hashes;
+
+    const auto lines = readFile( fileName ).split( '\n' );
+    for ( const auto& line : lines )
+    {
+        const auto pos = line.indexOf( '\t' );
+        if ( pos > 0 )
+            hashes.insert( QString::fromUtf8( line.mid( pos + 1 ) ), line.left( pos ) );
+    }
+
+    return hashes;
+}
+
+static void writeHashes( const QString& fileName,
+    const QHash< QString, QByteArray >& hashes )
+{
+    QFile file( fileName );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        return;
+
+    for ( auto it = hashes.constBegin(); it != hashes.constEnd(); ++it )
+        file.write( it.value() + '\t' + it.key().toUtf8() + '\n' );
+}
+
+static int convertBatch( const QString& manifest, Options options, int maxThreads )
+{
+    QFile file( manifest );
+    if ( !file.open( QIODevice::ReadOnly | QIODevice::Text ) )
+    {
+        qWarning() << "Can't open" << manifest;
+        return -2;
+    }
+
+    const QDir dir = QFileInfo( manifest ).absoluteDir();
+
+    QVector< Job > jobs;
+
+    while ( !file.atEnd() )
+    {
+        const auto line = QString::fromUtf8( file.readLine() ).trimmed();
+
+        if ( line.isEmpty() || line.startsWith( '#' ) )
+            continue;
+
+        if ( line.startsWith( QLatin1String( "--" ) ) )
+        {
+            if ( !options.parse( line ) )
+            {
+                qWarning() << "Invalid option in" << manifest << ":" << line;
+                return -1;
+            }
+
+            continue;
+        }
+
+        const auto files = line.split( '\t', Qt::SkipEmptyParts );
+        if ( files.count() != 2 )
+        {
+            qWarning() << "Invalid line in" << manifest << ":" << line;
+            return -1;
+        }
+
+        Job job;
+        job.svgFile = dir.absoluteFilePath( files[0].trimmed() );
+        job.qvgFile = dir.absoluteFilePath( files[1].trimmed() );
+
+        jobs += job;
+    }
+
+    /*
+        The hashes of the previous run: a file is skipped, when
+        its content and the options did not change.
+     */
+    const auto hashFile = manifest + QStringLiteral( ".hashes" );
+    auto hashes = readHashes( hashFile );
+
+    QThreadPool pool;
+    if ( maxThreads > 0 )
+        pool.setMaxThreadCount( maxThreads );
+
+    QMutex mutex;
+    std::atomic< int > failures( 0 );
+    std::atomic< int > skipped( 0 );
+
+    for ( const auto& job : std::as_const( jobs ) )
+    {
+        pool.start( [ job, options, &hashes, &mutex, &failures, &skipped ]()
+        {
+            const auto svgData = readFile( job.svgFile );
+            if ( svgData.isEmpty() )
+            {
+                qWarning() << "Can't read" << job.svgFile;
+                failures++;
+                return;
+            }
+
+            QCryptographicHash hash( QCryptographicHash::Sha1 );
+            hash.addData( svgData );
+            hash.addData( options.signature() );
+
+            const auto key = hash.result().toHex();
+
+            {
+                QMutexLocker locker( &mutex );
+
+                if ( hashes.value( job.qvgFile ) == key && QFile::exists( job.qvgFile ) )
+                {
+                    skipped++;
+                    return;
+                }
+
+                hashes.remove( job.qvgFile );
+            }
+
+            if ( convert( svgData, job.svgFile, job.qvgFile, options ) )
+            {
+                QMutexLocker locker( &mutex );
+                hashes.insert( job.qvgFile, key );
+            }
+            else
+            {
+                qWarning() << "Can't convert" << job.svgFile;
+                failures++;
+            }
+        } );
     }
 
+    pool.waitForDone();
+
+    writeHashes( hashFile, hashes );
+
+    qDebug() << "Converted" << jobs.count() - skipped - failures << "files,"
+        << "skipped" << skipped.load() << "unmodified,"
+        << failures.load() << "failures";
+
+    return ( failures > 0 ) ? -2 : 0;
+}
+
+int main( int argc, char* argv[] )
+{
 #if 0
     /*
         When there are no "text" parts in the SVGs we can avoid
@@ -89,22 +334,56 @@ int main( int argc, char* argv[] )
     QGuiApplication app( argc, argv );
 #endif
 
-    QSvgRenderer renderer;
-    if ( !renderer.load( QString( argv[1] ) ) )
-        return -2;
+    const auto args = app.arguments();
 
-    Graphic graphic;
-    graphic.setViewBox( ::viewBox( renderer ) );
+    Options options;
+    QString manifest;
+    int maxThreads = 0;
 
-    QPainter painter( &graphic );
-    renderer.render( &painter );
-    painter.end();
+    int i = 1;
+    for ( ; i < args.count() && args[i].startsWith( '-' ); i++ )
+    {
+        if ( options.parse( args[i] ) )
+            continue;
 
-    if ( graphic.commandTypes() & QskGraphic::RasterData )
-        qWarning() << argv[1] << "contains non scalable parts.";
+        if ( args[i] == QLatin1String( "--batch" ) && i + 1 < args.count() )
+        {
+            manifest = args[ ++i ];
+        }
+        else if ( args[i] == QLatin1String( "--jobs" ) && i + 1 < args.count() )
+        {
+            maxThreads = args[ ++i ].toInt();
+        }
+        else
+        {
+            usage( argv[0] );
+            return -1;
+        }
+    }
+
+    if ( !manifest.isEmpty() )
+    {
+        if ( i != args.count() )
+        {
+            usage( argv[0] );
+            return -1;
+        }
 
-    QskGraphicIO::write( graphic, argv[2] );
+        return convertBatch( manifest, options, maxThreads );
+    }
+
+    if ( args.count() - i != 2 )
+    {
+        usage( argv[0] );
+        return -1;
+    }
+
+    const auto svgFile = args[i];
+    const auto qvgFile = args[i + 1];
+
+    const auto svgData = readFile( svgFile );
+    if ( svgData.isEmpty() || !convert( svgData, svgFile, qvgFile, options ) )
+        return -2;
 
     return 0;
 }
-